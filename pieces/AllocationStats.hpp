@@ -0,0 +1,192 @@
+// Heap memory held by parsed values, counted from their capacities when the
+// value is complete. Allocations made and freed during parsing are not seen.
+struct MemoryStats {
+    size_t values;  // Number of values counted.
+    size_t bytes;   // Bytes held by all counted values.
+    size_t blocks;  // Heap blocks held by all counted values.
+    size_t largest; // Most bytes held by one value.
+
+    MemoryStats() : values(0), bytes(0), blocks(0), largest(0) { }
+    void Add(size_t Bytes, size_t Blocks) {
+        ++values;
+        bytes += Bytes;
+        blocks += Blocks;
+        if (largest < Bytes)
+            largest = Bytes;
+    }
+};
+
+// Types that hold memory in other ways can provide an overload found via
+// argument-dependent lookup, as StringTable does.
+template<typename T>
+void memory_use(const T& Value, size_t& Bytes, size_t& Blocks);
+
+template<typename C, typename T, typename A>
+void string_memory_use(const std::basic_string<C,T,A>& Value,
+    size_t& Bytes, size_t& Blocks)
+{
+    if (std::basic_string<C,T,A>(Value.get_allocator()).capacity() <
+        Value.capacity())
+    {
+        Bytes += (Value.capacity() + 1) * sizeof(C);
+        ++Blocks;
+    }
+}
+
+template<typename T, typename A>
+void vector_memory_use(const std::vector<T,A>& Value,
+    size_t& Bytes, size_t& Blocks)
+{
+    if (Value.capacity()) {
+        Bytes += Value.capacity() * sizeof(T);
+        ++Blocks;
+    }
+    for (const auto& item : Value)
+        memory_use(item, Bytes, Blocks);
+}
+
+// Only used to find out whether a type is derived from a string or vector.
+template<typename C, typename T, typename A>
+std::true_type is_string_based(const std::basic_string<C,T,A>*);
+std::false_type is_string_based(const void*);
+template<typename T, typename A>
+std::true_type is_vector_based(const std::vector<T,A>*);
+std::false_type is_vector_based(const void*);
+
+// Strings and vectors, including derived types such as PmrString, hold heap
+// memory. Scalars and unknown types hold none.
+template<typename T>
+void memory_use(const T& Value, size_t& Bytes, size_t& Blocks) {
+    if constexpr (decltype(is_string_based(&Value))::value)
+        string_memory_use(Value, Bytes, Blocks);
+    else if constexpr (decltype(is_vector_based(&Value))::value)
+        vector_memory_use(Value, Bytes, Blocks);
+}
+
+template<typename... Items>
+void memory_use(const std::tuple<Items...>& Value,
+    size_t& Bytes, size_t& Blocks)
+{
+    std::apply([&Bytes, &Blocks](const auto&... Item) {
+        (memory_use(Item, Bytes, Blocks), ...);
+    }, Value);
+}
+
+// Fields of a generated type.
+template<typename... Parsers>
+void memory_use(const std::tuple<Value<Parsers>...>& Fields,
+    size_t& Bytes, size_t& Blocks)
+{
+    std::apply([&Bytes, &Blocks](const auto&... Field) {
+        (memory_use(Field.value, Bytes, Blocks), ...);
+    }, Fields);
+}
+
+// Memory use per generated type and its fields.
+class AllocationStats {
+public:
+    struct TypeStats {
+        MemoryStats total;
+        std::vector<const char*> names;
+        std::vector<MemoryStats> fields;
+    };
+
+    std::map<const char*, TypeStats> types;
+
+    template<typename KeyValues, typename Fields>
+    void Count(const char* Name, KeyValues& Parsers, const Fields& Values) {
+        TypeStats& stats(types[Name]);
+        if (stats.names.empty())
+            for (size_t k = 0; k < Parsers.size(); ++k)
+                stats.names.push_back(Parsers.KeyValue(k)->Key());
+        stats.fields.resize(stats.names.size());
+        size_t bytes = 0, blocks = 0;
+        count(stats, Values, bytes, blocks,
+            std::make_index_sequence<std::tuple_size<Fields>::value> {});
+        stats.total.Add(bytes, blocks);
+    }
+
+    void Clear() { types.clear(); }
+
+private:
+    template<typename Fields, size_t... IdxSeq>
+    void count(TypeStats& Stats, const Fields& Values,
+        size_t& Bytes, size_t& Blocks, std::index_sequence<IdxSeq...>)
+    {
+        auto field = [&](MemoryStats& S, const auto& Value) {
+            size_t bytes = 0, blocks = 0;
+            memory_use(Value, bytes, blocks);
+            S.Add(bytes, blocks);
+            Bytes += bytes;
+            Blocks += blocks;
+        };
+        (field(Stats.fields[IdxSeq], std::get<IdxSeq>(Values).value), ...);
+    }
+};
+
+// Object parser that adds memory use of each parsed object to Pool.Stats.
+template<typename KeyValues, typename Values, const char* Name>
+class CountingParseObject : public ParseObject<KeyValues,Values> {
+public:
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false)
+    {
+        Begin = ParseObject<KeyValues,Values>::Parse(Begin, End, Pool);
+        if (Begin != nullptr && Pool.Stats != nullptr)
+            Pool.Stats->Count(Name, this->parsers, this->out.fields);
+        return Begin;
+    }
+};
+
+template<typename Sink>
+void Write(Sink& S, const MemoryStats& Value, std::vector<char>& Buffer) {
+    const char* names[] = { "values", "bytes", "blocks", "largest" };
+    const size_t counts[] = {
+        Value.values, Value.bytes, Value.blocks, Value.largest };
+    char c = '{';
+    for (int k = 0; k < 4; ++k) {
+        S.write(&c, 1);
+        Write(S, names[k], names[k] + std::strlen(names[k]), Buffer);
+        c = ':';
+        S.write(&c, 1);
+        Write(S, static_cast<std::uint64_t>(counts[k]), Buffer);
+        c = ',';
+    }
+    c = '}';
+    S.write(&c, 1);
+}
+
+// Writes {"Type":{"values":...,"fields":{"field":{"values":...}}}}.
+template<typename Sink>
+void Write(Sink& S, const AllocationStats& Value, std::vector<char>& Buffer) {
+    char c = '{';
+    for (const auto& type : Value.types) {
+        S.write(&c, 1);
+        Write(S, type.first, type.first + std::strlen(type.first), Buffer);
+        const char total[] = ":{\"total\":";
+        S.write(total, sizeof(total) - 1);
+        Write(S, type.second.total, Buffer);
+        const char fields[] = ",\"fields\":";
+        S.write(fields, sizeof(fields) - 1);
+        c = '{';
+        for (size_t k = 0; k < type.second.names.size(); ++k) {
+            S.write(&c, 1);
+            const char* name = type.second.names[k];
+            Write(S, name, name + std::strlen(name), Buffer);
+            c = ':';
+            S.write(&c, 1);
+            Write(S, type.second.fields[k], Buffer);
+            c = ',';
+        }
+        if (c == '{')
+            S.write(&c, 1);
+        c = '}';
+        S.write(&c, 1);
+        S.write(&c, 1);
+        c = ',';
+    }
+    if (c == '{')
+        S.write(&c, 1);
+    c = '}';
+    S.write(&c, 1);
+}
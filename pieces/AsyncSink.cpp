@@ -0,0 +1,109 @@
+specjson::AsyncSink::AsyncSink(int FileDescriptor, size_t BufferSize)
+    : fd_sink(new FileDescriptorSink(FileDescriptor, 1, 1)), stream(nullptr),
+    used(0), pending_size(0), filling(0), pending(false), closing(false),
+    closed(false)
+{
+    buffers[0].resize(BufferSize ? BufferSize : 1);
+    buffers[1].resize(buffers[0].size());
+    writer = std::thread(&AsyncSink::run, this);
+}
+
+specjson::AsyncSink::AsyncSink(std::ostream& Stream, size_t BufferSize)
+    : stream(&Stream), used(0), pending_size(0), filling(0), pending(false),
+    closing(false), closed(false)
+{
+    buffers[0].resize(BufferSize ? BufferSize : 1);
+    buffers[1].resize(buffers[0].size());
+    writer = std::thread(&AsyncSink::run, this);
+}
+
+specjson::AsyncSink::~AsyncSink() {
+    try {
+        close();
+    }
+    catch (...) { }
+}
+
+void specjson::AsyncSink::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [this]() { return pending || closing; });
+        if (!pending)
+            return;
+        const char* data = buffers[filling ^ 1].data();
+        size_t size = pending_size;
+        bool failed = static_cast<bool>(error);
+        lock.unlock();
+        std::exception_ptr failure;
+        if (!failed) {
+            try {
+                if (stream != nullptr) {
+                    stream->write(data, size);
+                    if (!*stream)
+                        throw SinkWriteFailed;
+                } else
+                    fd_sink->write(data, size);
+            }
+            catch (...) {
+                failure = std::current_exception();
+            }
+        }
+        lock.lock();
+        if (failure)
+            error = failure;
+        pending = false;
+        changed.notify_all();
+    }
+}
+
+void specjson::AsyncSink::hand_off() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() { return !pending; });
+    if (error)
+        std::rethrow_exception(error);
+    if (used == 0)
+        return;
+    pending_size = used;
+    pending = true;
+    filling ^= 1;
+    used = 0;
+    changed.notify_all();
+}
+
+void specjson::AsyncSink::write(const char* Data, size_t Count) {
+    while (true) {
+        size_t part = std::min(Count, buffers[filling].size() - used);
+        std::memcpy(buffers[filling].data() + used, Data, part);
+        used += part;
+        Data += part;
+        Count -= part;
+        if (Count == 0)
+            return;
+        hand_off();
+    }
+}
+
+void specjson::AsyncSink::close() {
+    if (closed)
+        return;
+    std::exception_ptr failure;
+    try {
+        hand_off();
+    }
+    catch (...) {
+        failure = std::current_exception();
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() { return !pending; });
+    closing = true;
+    changed.notify_all();
+    lock.unlock();
+    writer.join();
+    closed = true;
+    if (stream != nullptr)
+        stream->flush();
+    if (!failure)
+        failure = error;
+    if (failure)
+        std::rethrow_exception(failure);
+}
@@ -0,0 +1,33 @@
+// Sink for Write functions that fills one buffer while a background thread
+// writes the other one to a file descriptor or a stream, so formatting and
+// output overlap. Memory use is two buffers. A failed write is thrown from a
+// later write or from close. Call close when done, as the destructor ignores
+// errors.
+class AsyncSink {
+private:
+    std::unique_ptr<FileDescriptorSink> fd_sink;
+    std::ostream* stream;
+    std::vector<char> buffers[2];
+    size_t used, pending_size;
+    int filling;
+    bool pending, closing, closed;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread writer;
+
+    void run();
+    void hand_off() noexcept(false);
+
+public:
+    AsyncSink(int FileDescriptor, size_t BufferSize = 1048576);
+    AsyncSink(std::ostream& Stream, size_t BufferSize = 1048576);
+    AsyncSink(const AsyncSink&) = delete;
+    AsyncSink& operator=(const AsyncSink&) = delete;
+    ~AsyncSink();
+
+    void write(const char* Data, size_t Count) noexcept(false);
+    // Writes the rest of the data, stops the thread and throws if a write
+    // failed.
+    void close() noexcept(false);
+};
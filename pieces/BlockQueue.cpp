@@ -0,0 +1,84 @@
+//
+//  BlockQueue.cpp
+//  imageio
+//
+//  Created by Ismo Kärkkäinen on 10.2.2020.
+//  Copyright © 2020 Ismo Kärkkäinen. All rights reserved.
+//
+// Licensed under Universal Permissive License. See License.txt.
+
+specjson::BlockQueue::BlockPtr specjson::BlockQueue::dequeue(
+    std::unique_lock<std::mutex>& lock, bool wait)
+{
+    if (wait)
+        waiter.wait(lock, [this]() { return !queue.empty() || ended; });
+    if (queue.empty())
+        return BlockPtr();
+    BlockPtr tmp(queue.back());
+    queue.pop_back();
+    return tmp;
+}
+
+specjson::BlockQueue::~BlockQueue() {
+    // Any thread waiting at this point has dequeue access destructed object.
+    waiter.notify_all();
+    recycled.notify_all();
+}
+
+specjson::BlockQueue::BlockPtr specjson::BlockQueue::Add(BlockPtr& Filled) {
+    std::unique_lock<std::mutex> lock(mutex);
+    queue.push_front(Filled);
+    waiter.notify_one();
+    // The first block came from the caller.
+    if (available.empty() && max_blocks && max_blocks <= allocated + 1)
+        recycled.wait(lock, [this]() { return !available.empty() || ended; });
+    if (!available.empty()) {
+        BlockPtr tmp(available.back());
+        available.pop_back();
+        return tmp;
+    }
+    if (ended)
+        return BlockPtr();
+    ++allocated;
+    lock.unlock();
+    return BlockPtr(new Block());
+}
+
+specjson::BlockQueue::BlockPtr specjson::BlockQueue::Remove(
+    BlockQueue::BlockPtr& Emptied, bool WaitForBlock)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (Emptied) {
+        available.push_back(Emptied);
+        recycled.notify_one();
+    }
+    return dequeue(lock, WaitForBlock);
+}
+
+specjson::BlockQueue::BlockPtr specjson::BlockQueue::Remove(bool WaitForBlock) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return dequeue(lock, WaitForBlock);
+}
+
+void specjson::BlockQueue::End() {
+    std::unique_lock<std::mutex> lock(mutex);
+    ended = true;
+    lock.unlock();
+    waiter.notify_all();
+    recycled.notify_all();
+}
+
+bool specjson::BlockQueue::Ended() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return ended && queue.empty();
+}
+
+bool specjson::BlockQueue::Empty() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.empty();
+}
+
+size_t specjson::BlockQueue::Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size();
+}
@@ -7,18 +7,6 @@
 //
 // Licensed under Universal Permissive License. See License.txt.
 
-#ifndef BlockQueue_hpp
-#define BlockQueue_hpp
-
-#include <vector>
-#include <deque>
-#include <memory>
-#include <mutex>
-#if defined(__GNUG__)
-#include <condition_variable>
-#endif
-
-
 class BlockQueue {
 public:
     typedef std::vector<char> Block;
@@ -26,21 +14,29 @@ public:
 
 private:
     mutable std::mutex mutex;
-    std::condition_variable waiter;
+    std::condition_variable waiter, recycled;
     std::deque<BlockPtr> queue;
-    BlockPtr available;
+    std::vector<BlockPtr> available;
+    size_t allocated, max_blocks;
     bool ended;
 
     BlockPtr dequeue(std::unique_lock<std::mutex>& lock, bool wait);
 
 public:
-    BlockQueue() : ended(false) { }
+    // At most MaxBlocks blocks are in use, counting the block that the caller
+    // gives to the first Add, 0 for no limit.
+    BlockQueue(size_t MaxBlocks = 0)
+        : allocated(0), max_blocks(MaxBlocks), ended(false) { }
     ~BlockQueue();
     BlockQueue(const BlockQueue&) = delete;
     BlockQueue& operator=(const BlockQueue&) = delete;
 
-    BlockPtr Add(BlockPtr& Filled); // Returns new/recycled block to fill.
-    // These return nullptrs if nothing present.
+    // Returns recycled or new block to fill. When MaxBlocks are in use,
+    // waits for a block to be recycled. Returns nullptr if End
+    // is called while waiting.
+    BlockPtr Add(BlockPtr& Filled);
+    // These return nullptrs if nothing present. With WaitForBlock they wait
+    // until a block is added or End is called.
     BlockPtr Remove(BlockPtr& Emptied, bool WaitForBlock = false);
     BlockPtr Remove(bool WaitForBlock = false);
 
@@ -50,6 +46,3 @@ public:
     bool Empty() const;
     size_t Size() const;
 };
-
-
-#endif /* BlockQueue_hpp */
@@ -0,0 +1,118 @@
+//
+//  BlockRing.cpp
+//  specificjson
+//
+//  Copyright © 2020-2022 Ismo Kärkkäinen. All rights reserved.
+//
+// Licensed under Universal Permissive License. See License.txt.
+
+specjson::BlockRing::BlockRing(
+    size_t Blocks, size_t BlockSize, bool HugePages)
+    : slots(Blocks ? Blocks : 1), memory(nullptr), block_size(BlockSize),
+    head(0), tail(0), ended(false), stopped(false), consumer_waiting(false),
+    producer_waiting(false), acquired(0), held(false)
+{
+    const size_t alignment = HugePages ? 2097152 : 4096;
+    size_t bytes = slots.size() * block_size;
+    bytes = (bytes + alignment - 1) / alignment * alignment;
+    memory = static_cast<char*>(std::aligned_alloc(alignment, bytes));
+    if (memory == nullptr)
+        throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+    if (HugePages)
+        madvise(memory, bytes, MADV_HUGEPAGE);
+#endif
+    for (size_t k = 0; k < slots.size(); ++k) {
+        slots[k].data = memory + k * block_size;
+        slots[k].size = 0;
+    }
+}
+
+specjson::BlockRing::~BlockRing() {
+    std::free(memory);
+}
+
+template<typename Ready>
+void specjson::BlockRing::wait(std::condition_variable& Waiter,
+    std::atomic<bool>& Waiting, Ready&& IsReady)
+{
+    for (int k = 0; k < 64; ++k)
+        if (IsReady())
+            return;
+    std::unique_lock<std::mutex> lock(mutex);
+    // The other side stores its index before it checks Waiting, and this
+    // stores Waiting before checking the index, so one of them sees the other.
+    Waiting = true;
+    Waiter.wait(lock, IsReady);
+    Waiting = false;
+}
+
+void specjson::BlockRing::wake(
+    std::condition_variable& Waiter, std::atomic<bool>& Waiting)
+{
+    if (!Waiting)
+        return;
+    std::lock_guard<std::mutex> lock(mutex);
+    Waiter.notify_one();
+}
+
+size_t specjson::BlockRing::Acquire(struct iovec* Vectors, size_t Max) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    wait(fillable, producer_waiting, [this, t]() {
+        return t - head.load() < slots.size() || stopped.load(); });
+    if (stopped)
+        return 0;
+    size_t available = slots.size() - (t - head.load());
+    acquired = std::min(available, Max);
+    for (size_t k = 0; k < acquired; ++k) {
+        Slot& slot(slots[(t + k) % slots.size()]);
+        Vectors[k].iov_base = slot.data;
+        Vectors[k].iov_len = block_size;
+    }
+    return acquired;
+}
+
+void specjson::BlockRing::Publish(size_t Bytes) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t k = 0;
+    for (; k < acquired && 0 < Bytes; ++k) {
+        Slot& slot(slots[(t + k) % slots.size()]);
+        slot.size = std::min(Bytes, block_size);
+        Bytes -= slot.size;
+    }
+    acquired = 0;
+    if (k == 0)
+        return;
+    tail.store(t + k);
+    wake(consumable, consumer_waiting);
+}
+
+void specjson::BlockRing::End() {
+    ended = true;
+    std::lock_guard<std::mutex> lock(mutex);
+    consumable.notify_one();
+}
+
+bool specjson::BlockRing::Next(const char*& Begin, const char*& End) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (held) {
+        held = false;
+        head.store(++h);
+        wake(fillable, producer_waiting);
+    }
+    wait(consumable, consumer_waiting, [this, h]() {
+        return h != tail.load() || ended.load(); });
+    if (h == tail.load())
+        return false;
+    const Slot& slot(slots[h % slots.size()]);
+    Begin = slot.data;
+    End = Begin + slot.size;
+    held = true;
+    return true;
+}
+
+void specjson::BlockRing::Stop() {
+    stopped = true;
+    std::lock_guard<std::mutex> lock(mutex);
+    fillable.notify_one();
+}
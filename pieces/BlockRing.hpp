@@ -0,0 +1,59 @@
+//
+//  BlockRing.hpp
+//  specificjson
+//
+//  Copyright © 2020-2022 Ismo Kärkkäinen. All rights reserved.
+//
+// Licensed under Universal Permissive License. See License.txt.
+
+// Bounded single-producer single-consumer ring of preallocated blocks. The
+// producer fills free blocks and publishes them, the consumer takes them in
+// order and releases each when it asks for the next one. Indexes are atomic
+// and a side only takes the mutex to wake the other when that is waiting.
+class BlockRing {
+private:
+    struct Slot {
+        char* data;
+        size_t size;
+    };
+    std::vector<Slot> slots;
+    char* memory;
+    size_t block_size;
+    std::atomic<size_t> head, tail; // Consumed and published block counts.
+    std::atomic<bool> ended, stopped, consumer_waiting, producer_waiting;
+    size_t acquired;
+    bool held;
+    std::mutex mutex;
+    std::condition_variable consumable, fillable;
+
+    template<typename Ready>
+    void wait(std::condition_variable& Waiter, std::atomic<bool>& Waiting,
+        Ready&& IsReady);
+    void wake(std::condition_variable& Waiter, std::atomic<bool>& Waiting);
+
+public:
+    // All blocks are in one allocation of Blocks * BlockSize bytes, which is
+    // all the memory the ring uses. With HugePages the allocation is aligned
+    // to 2 MiB and the system is advised to back it with huge pages.
+    BlockRing(size_t Blocks, size_t BlockSize, bool HugePages = false);
+    BlockRing(const BlockRing&) = delete;
+    BlockRing& operator=(const BlockRing&) = delete;
+    ~BlockRing();
+
+    size_t BlockSize() const { return block_size; }
+
+    // Producer. Waits for a free block and sets at most Max Vectors to the
+    // consecutive free blocks. Returns their count, 0 if Stop was called.
+    size_t Acquire(struct iovec* Vectors, size_t Max);
+    // Fills the acquired blocks in order with Bytes in total and passes the
+    // blocks that received any to the consumer.
+    void Publish(size_t Bytes);
+    // No more blocks will be published.
+    void End();
+
+    // Consumer. Releases the previous block and waits for the next. Returns
+    // false when End was called and all blocks have been taken.
+    bool Next(const char*& Begin, const char*& End);
+    // Makes Acquire return 0 so that the producer stops.
+    void Stop();
+};
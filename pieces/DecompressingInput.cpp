@@ -0,0 +1,205 @@
+const Exception specjson::DecompressionFailed(
+    "Compressed input is invalid or truncated.");
+const Exception specjson::DecompressionUnavailable(
+    "Decompression for input format is not available.");
+
+specjson::DecompressingInput::DecompressingInput(
+    InputChannel& Source, size_t BufferSize, Format Compression)
+    : source(Source), format(Compression), input(BufferSize ? BufferSize : 1),
+    begin(0), end(0), stream(nullptr), pending(false), open(false)
+{
+    if (input.size() < 4)
+        input.resize(4);
+    if (format != Detect)
+        start();
+}
+
+specjson::DecompressingInput::~DecompressingInput() {
+    if (stream == nullptr)
+        return;
+#if SPECJSON_ZLIB
+    if (format == Gzip) {
+        z_stream* z = static_cast<z_stream*>(stream);
+        inflateEnd(z);
+        delete z;
+    }
+#endif
+#if SPECJSON_ZSTD
+    if (format == Zstd)
+        ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(stream));
+#endif
+}
+
+bool specjson::DecompressingInput::Available(Format Compression) {
+    switch (Compression) {
+    case Gzip:
+#if SPECJSON_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case Zstd:
+#if SPECJSON_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return true;
+    }
+}
+
+void specjson::DecompressingInput::start() {
+    if (!Available(format))
+        throw DecompressionUnavailable;
+#if SPECJSON_ZLIB
+    if (format == Gzip) {
+        z_stream* z = new z_stream();
+        // Adding 32 detects gzip or zlib header.
+        if (inflateInit2(z, 15 + 32) != Z_OK) {
+            delete z;
+            throw DecompressionFailed;
+        }
+        stream = z;
+    }
+#endif
+#if SPECJSON_ZSTD
+    if (format == Zstd) {
+        stream = ZSTD_createDCtx();
+        if (stream == nullptr)
+            throw DecompressionFailed;
+    }
+#endif
+}
+
+bool specjson::DecompressingInput::fill() {
+    if (begin == end)
+        begin = end = 0;
+    else if (end == input.size()) {
+        std::memmove(input.data(), input.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    int got = source.Read(input.data() + end, input.size() - end);
+    if (got <= 0)
+        return false;
+    end += static_cast<size_t>(got);
+    return true;
+}
+
+bool specjson::DecompressingInput::detect() {
+    while (end - begin < 4 && !source.Ended())
+        if (!fill())
+            return false;
+    const unsigned char* b =
+        reinterpret_cast<const unsigned char*>(input.data() + begin);
+    size_t count = end - begin;
+    if (2 <= count && b[0] == 0x1f && b[1] == 0x8b)
+        format = Gzip;
+    else if (4 <= count &&
+        b[0] == 0x28 && b[1] == 0xb5 && b[2] == 0x2f && b[3] == 0xfd)
+        format = Zstd;
+    else
+        format = None;
+    if (format != None)
+        start();
+    return true;
+}
+
+size_t specjson::DecompressingInput::decode(char* Buffer, size_t Length) {
+#if SPECJSON_ZLIB
+    if (format == Gzip) {
+        z_stream* z = static_cast<z_stream*>(stream);
+        z->next_in = reinterpret_cast<Bytef*>(input.data() + begin);
+        z->avail_in = static_cast<uInt>(end - begin);
+        z->next_out = reinterpret_cast<Bytef*>(Buffer);
+        z->avail_out = static_cast<uInt>(
+            std::min(Length, static_cast<size_t>(UINT_MAX)));
+        uInt space = z->avail_out;
+        if (z->avail_in)
+            open = true;
+        int result = inflate(z, Z_NO_FLUSH);
+        begin = end - z->avail_in;
+        size_t produced = space - z->avail_out;
+        if (result == Z_STREAM_END) {
+            // Another gzip member may follow.
+            if (inflateReset(z) != Z_OK)
+                throw DecompressionFailed;
+            pending = open = false;
+        } else if (result == Z_BUF_ERROR)
+            pending = false; // Needs more input.
+        else if (result != Z_OK)
+            throw DecompressionFailed;
+        else
+            pending = z->avail_out == 0;
+        return produced;
+    }
+#endif
+#if SPECJSON_ZSTD
+    if (format == Zstd) {
+        ZSTD_inBuffer in = { input.data() + begin, end - begin, 0 };
+        ZSTD_outBuffer out = { Buffer, Length, 0 };
+        if (in.size)
+            open = true;
+        size_t result = ZSTD_decompressStream(
+            static_cast<ZSTD_DCtx*>(stream), &out, &in);
+        if (ZSTD_isError(result))
+            throw DecompressionFailed;
+        begin += in.pos;
+        // Zero means the frame is done and all of it is in the output.
+        open = result != 0;
+        pending = out.pos == out.size;
+        return out.pos;
+    }
+#endif
+    throw DecompressionUnavailable;
+}
+
+int specjson::DecompressingInput::Read(char* Buffer, size_t Length) {
+    Length = std::min(Length, static_cast<size_t>(INT_MAX));
+    if (format == Detect && !detect())
+        return 0;
+    if (format == None) {
+        if (begin == end)
+            return source.Read(Buffer, Length);
+        size_t count = std::min(Length, end - begin);
+        std::memcpy(Buffer, input.data() + begin, count);
+        begin += count;
+        return static_cast<int>(count);
+    }
+    size_t produced = 0;
+    while (produced < Length) {
+        if (begin == end && !pending) {
+            // Return what is done rather than wait for more input.
+            if (produced)
+                break;
+            if (source.Ended()) {
+                if (open)
+                    throw DecompressionFailed;
+                break;
+            }
+            if (!fill())
+                break;
+        }
+        produced += decode(Buffer + produced, Length - produced);
+    }
+    return static_cast<int>(produced);
+}
+
+int specjson::DecompressingInput::Read(const struct iovec* Buffers, int Count)
+{
+    int total = 0;
+    for (int k = 0; k < Count; ++k) {
+        int got = Read(static_cast<char*>(Buffers[k].iov_base),
+            Buffers[k].iov_len);
+        total += got;
+        if (static_cast<size_t>(got) < Buffers[k].iov_len)
+            break;
+    }
+    return total;
+}
+
+bool specjson::DecompressingInput::Ended() {
+    // Open means the stream ended in the middle and Read will throw.
+    return source.Ended() && begin == end && !pending && !open;
+}
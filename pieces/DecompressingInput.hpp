@@ -0,0 +1,39 @@
+extern const Exception DecompressionFailed;
+extern const Exception DecompressionUnavailable;
+
+// Decompresses what Source reads. The format is detected from the first bytes
+// unless given, and input that is not compressed is passed through. Gzip and
+// zlib streams are decompressed with zlib and zstd with libzstd, when found at
+// build time. Concatenated gzip members and zstd frames are all read. Used
+// with StreamParser, the decompression runs in the reading thread.
+class DecompressingInput : public InputChannel {
+public:
+    enum Format { Detect, None, Gzip, Zstd };
+
+private:
+    InputChannel& source;
+    Format format;
+    std::vector<char> input;
+    size_t begin, end;
+    void* stream;
+    bool pending, open;
+
+    bool detect();
+    void start();
+    bool fill();
+    size_t decode(char* Buffer, size_t Length) noexcept(false);
+
+public:
+    // BufferSize is the size of the buffer for compressed input.
+    DecompressingInput(InputChannel& Source, size_t BufferSize = 262144,
+        Format Compression = Detect) noexcept(false);
+    DecompressingInput(const DecompressingInput&) = delete;
+    DecompressingInput& operator=(const DecompressingInput&) = delete;
+    ~DecompressingInput();
+    int Read(char* Buffer, size_t Length) noexcept(false);
+    int Read(const struct iovec* Buffers, int Count) noexcept(false);
+    bool Ended();
+
+    // Returns true if the format can be decompressed in this build.
+    static bool Available(Format Compression);
+};
@@ -7,5 +7,5 @@ ContextException::ContextException(const Exception& E,
     size_t space = (63 - strlen(context)) / 2;
     size_t before = (space < Current - Begin) ? space : (Current - Begin);
     size_t after = (space < End - Current) ? space : (End - Current);
-    std::strncat(context, Current - before, before + after + 1);
+    std::strncat(context, Current - before, before + after);
 }
@@ -0,0 +1,61 @@
+//
+//  FileDescriptorInput.cpp
+//  imageio / datalackey
+//
+//  Created by Ismo Kärkkäinen on 24.5.17.
+//  Copyright © 2017, 2020 Ismo Kärkkäinen. All rights reserved.
+//
+// Licensed under Universal Permissive License. See License.txt.
+
+specjson::FileDescriptorInput::FileDescriptorInput(
+    int FileDescriptor, int Timeout)
+    : eof(false), fd(FileDescriptor), timeout(Timeout)
+{ }
+
+specjson::FileDescriptorInput::~FileDescriptorInput() { }
+
+bool specjson::FileDescriptorInput::ready() {
+    struct pollfd p;
+    p.fd = fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    errno = 0;
+    int avail = poll(&p, 1, timeout);
+    if (avail <= 0) {
+        eof = avail < 0 && !(errno == EINTR || errno == EAGAIN);
+        return false;
+    }
+    if (p.revents & POLLNVAL) {
+        eof = true;
+        return false;
+    }
+    // Data, hang-up or error. Read tells which.
+    return true;
+}
+
+int specjson::FileDescriptorInput::got(ssize_t Count) {
+    if (Count <= 0) {
+        eof = Count == 0 || !(errno == EAGAIN || errno == EINTR);
+        return 0;
+    }
+    return static_cast<int>(Count);
+}
+
+int specjson::FileDescriptorInput::Read(char* Buffer, size_t Length) {
+    if (!ready())
+        return 0;
+    errno = 0;
+    return got(read(fd, Buffer, Length));
+}
+
+int specjson::FileDescriptorInput::Read(const struct iovec* Buffers, int Count)
+{
+    if (!ready())
+        return 0;
+    errno = 0;
+    return got(readv(fd, Buffers, Count));
+}
+
+bool specjson::FileDescriptorInput::Ended() {
+    return eof;
+}
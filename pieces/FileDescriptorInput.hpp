@@ -0,0 +1,29 @@
+//
+//  FileDescriptorInput.hpp
+//  imageio / datalackey
+//
+//  Created by Ismo Kärkkäinen on 24.5.17.
+//  Copyright © 2017, 2020 Ismo Kärkkäinen. All rights reserved.
+//
+// Licensed under Universal Permissive License. See License.txt.
+
+// Reads from a file descriptor. Read waits at most Timeout milliseconds for
+// input and returns 0 if there is none, so the caller can check whether to
+// stop. Negative Timeout waits until there is input or the end is reached,
+// and 0 returns at once.
+class FileDescriptorInput : public InputChannel {
+private:
+    bool eof;
+    int fd;
+    int timeout;
+
+    bool ready();
+    int got(ssize_t Count);
+
+public:
+    FileDescriptorInput(int FileDescriptor = 0, int Timeout = 100);
+    ~FileDescriptorInput();
+    int Read(char* Buffer, size_t Length);
+    int Read(const struct iovec* Buffers, int Count);
+    bool Ended();
+};
@@ -0,0 +1,72 @@
+const Exception specjson::SinkWriteFailed("Failed to write output.");
+
+specjson::FileDescriptorSink::FileDescriptorSink(
+    int FileDescriptor, size_t BufferSize, size_t Direct)
+    : fd(FileDescriptor), buffer(BufferSize ? BufferSize : 1), used(0),
+    direct(std::min(Direct, buffer.size()))
+{ }
+
+specjson::FileDescriptorSink::~FileDescriptorSink() {
+    try {
+        Flush();
+    }
+    catch (...) { }
+}
+
+void specjson::FileDescriptorSink::output(struct iovec* Vectors, int Count) {
+    while (0 < Count) {
+        ssize_t written = writev(fd, Vectors, Count);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                struct pollfd p;
+                p.fd = fd;
+                p.events = POLLOUT;
+                p.revents = 0;
+                poll(&p, 1, -1);
+                continue;
+            }
+            throw SinkWriteFailed;
+        }
+        // Skip what was written, possibly part of a vector.
+        size_t left = static_cast<size_t>(written);
+        while (0 < Count && Vectors->iov_len <= left) {
+            left -= Vectors->iov_len;
+            ++Vectors;
+            --Count;
+        }
+        if (0 < Count) {
+            Vectors->iov_base = static_cast<char*>(Vectors->iov_base) + left;
+            Vectors->iov_len -= left;
+        }
+    }
+}
+
+void specjson::FileDescriptorSink::write(const char* Data, size_t Count) {
+    if (Count < direct) {
+        if (buffer.size() - used < Count)
+            Flush();
+        std::memcpy(buffer.data() + used, Data, Count);
+        used += Count;
+        return;
+    }
+    struct iovec vectors[2];
+    vectors[0].iov_base = buffer.data();
+    vectors[0].iov_len = used;
+    vectors[1].iov_base = const_cast<char*>(Data);
+    vectors[1].iov_len = Count;
+    used = 0;
+    output(vectors[0].iov_len ? vectors : vectors + 1,
+        vectors[0].iov_len ? 2 : 1);
+}
+
+void specjson::FileDescriptorSink::Flush() {
+    if (used == 0)
+        return;
+    struct iovec vector;
+    vector.iov_base = buffer.data();
+    vector.iov_len = used;
+    used = 0;
+    output(&vector, 1);
+}
@@ -0,0 +1,25 @@
+extern const Exception SinkWriteFailed;
+
+// Sink for Write functions that outputs to a file descriptor. Small writes
+// are gathered into one large buffer that is written when full. Larger
+// writes are passed with the buffered data to one writev call without
+// copying. Call Flush when done, as the destructor ignores errors.
+class FileDescriptorSink {
+private:
+    int fd;
+    std::vector<char> buffer;
+    size_t used, direct;
+
+    void output(struct iovec* Vectors, int Count) noexcept(false);
+
+public:
+    // Writes of at least Direct bytes are not copied to the buffer.
+    FileDescriptorSink(int FileDescriptor, size_t BufferSize = 1048576,
+        size_t Direct = 16384);
+    FileDescriptorSink(const FileDescriptorSink&) = delete;
+    FileDescriptorSink& operator=(const FileDescriptorSink&) = delete;
+    ~FileDescriptorSink();
+
+    void write(const char* Data, size_t Count) noexcept(false);
+    void Flush() noexcept(false);
+};
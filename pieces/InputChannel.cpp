@@ -0,0 +1,16 @@
+//
+//  InputChannel.cpp
+//  imageio / datalackey
+//
+//  Created by Ismo Kärkkäinen on 10.5.17.
+//  Copyright © 2017, 2020 Ismo Kärkkäinen. All rights reserved.
+//
+// Licensed under Universal Permissive License. See License.txt.
+
+specjson::InputChannel::~InputChannel() { }
+
+int specjson::InputChannel::Read(const struct iovec* Buffers, int Count) {
+    if (Count < 1)
+        return 0;
+    return Read(static_cast<char*>(Buffers[0].iov_base), Buffers[0].iov_len);
+}
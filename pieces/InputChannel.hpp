@@ -7,20 +7,14 @@
 //
 // Licensed under Universal Permissive License. See License.txt.
 
-#ifndef InputChannel_hpp
-#define InputChannel_hpp
-
-#include <cstddef>
-
-
 // Base class for input channels.
 class InputChannel {
 public:
     virtual ~InputChannel();
     virtual int Read(char* Buffer, size_t Length) = 0;
+    // Fills Buffers in order and returns the total byte count. The default
+    // reads only into the first buffer.
+    virtual int Read(const struct iovec* Buffers, int Count);
     // Return true if the channel has closed.
     virtual bool Ended() = 0;
 };
-
-
-#endif /* InputChannel_hpp */
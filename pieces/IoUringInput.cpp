@@ -0,0 +1,279 @@
+const Exception specjson::IoUringFailed(
+    "Could not wait for io_uring reads to complete.");
+
+specjson::IoUringInput::IoUringInput(
+    int FileDescriptor, unsigned Depth, bool UseUring, size_t BlockSize)
+    : fd(FileDescriptor), offset(lseek(FileDescriptor, 0, SEEK_CUR)),
+    seekable(0 <= offset), eof(false), ring_fd(-1), entries(0),
+    sq_ring(nullptr), sq_ring_size(0), cq_ring(nullptr), cq_ring_size(0),
+    sqes(nullptr), sqes_size(0), sq_tail(nullptr), sq_mask(nullptr),
+    sq_array(nullptr), cq_head(nullptr), cq_tail(nullptr), cq_mask(nullptr),
+    cqes(nullptr), block_size(BlockSize ? BlockSize : 1), first(0), used(0),
+    pending(0), taken(0), ahead(offset), short_read(false)
+{
+    if (seekable && UseUring && !setup(Depth ? Depth : 1))
+        teardown();
+}
+
+specjson::IoUringInput::~IoUringInput() {
+    // The kernel may write into the blocks until the reads complete.
+    try {
+        drain();
+    }
+    catch (const Exception&) { }
+    teardown();
+}
+
+void specjson::IoUringInput::teardown() {
+    if (sqes != nullptr)
+        munmap(sqes, sqes_size);
+    if (cq_ring != nullptr && cq_ring != sq_ring)
+        munmap(cq_ring, cq_ring_size);
+    if (sq_ring != nullptr)
+        munmap(sq_ring, sq_ring_size);
+    if (0 <= ring_fd)
+        close(ring_fd);
+    sqes = sq_ring = cq_ring = nullptr;
+    ring_fd = -1;
+    pending = 0;
+}
+
+#if defined(SPECJSON_IO_URING)
+
+bool specjson::IoUringInput::setup(unsigned Depth) {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, Depth, &params));
+    if (ring_fd < 0)
+        return false;
+    entries = params.sq_entries;
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes +
+        params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single)
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+    void* p = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+    if (p == MAP_FAILED)
+        return false;
+    sq_ring = p;
+    if (single)
+        cq_ring = sq_ring;
+    else {
+        p = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        if (p == MAP_FAILED)
+            return false;
+        cq_ring = p;
+    }
+    sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    p = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+    if (p == MAP_FAILED)
+        return false;
+    sqes = p;
+    char* sq = static_cast<char*>(sq_ring);
+    sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(cq_ring);
+    cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = cq + params.cq_off.cqes;
+    slots.resize(std::min(Depth, entries));
+    blocks.resize(slots.size() * block_size);
+    return true;
+}
+
+void specjson::IoUringInput::queue() {
+    struct io_uring_sqe* ring = static_cast<struct io_uring_sqe*>(sqes);
+    unsigned tail = *sq_tail;
+    int added = 0;
+    // Nothing is read past a short read until the caller has reached it.
+    while (!short_read && used < slots.size()) {
+        unsigned index = (first + used) % slots.size();
+        Slot& slot(slots[index]);
+        slot.vector.iov_base = blocks.data() + index * block_size;
+        slot.vector.iov_len = block_size;
+        slot.at = ahead;
+        slot.result = 0;
+        slot.done = false;
+        unsigned entry = tail & *sq_mask;
+        struct io_uring_sqe* sqe = &ring[entry];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(&slot.vector);
+        sqe->len = 1;
+        sqe->off = static_cast<std::uint64_t>(ahead);
+        sqe->user_data = static_cast<std::uint64_t>(index);
+        sq_array[entry] = entry;
+        ahead += block_size;
+        ++used;
+        ++added;
+        ++tail;
+    }
+    if (!added)
+        return;
+    __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+    while (0 < added) {
+        int got = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd,
+            added, 0, 0, nullptr, 0));
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0) {
+            // Entries that were not submitted are still in the ring, so it
+            // can not be used again. Reads continue with pread.
+            drain();
+            teardown();
+            return;
+        }
+        pending += got;
+        added -= got;
+    }
+}
+
+void specjson::IoUringInput::wait() noexcept(false) {
+    while (syscall(__NR_io_uring_enter, ring_fd, 0, 1,
+        IORING_ENTER_GETEVENTS, nullptr, 0) < 0)
+    {
+        if (errno != EINTR)
+            throw IoUringFailed;
+    }
+    const struct io_uring_cqe* done =
+        static_cast<const struct io_uring_cqe*>(cqes);
+    unsigned head = *cq_head;
+    unsigned end = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != end; ++head, --pending) {
+        const struct io_uring_cqe& cqe(done[head & *cq_mask]);
+        Slot& slot(slots[cqe.user_data]);
+        slot.result = cqe.res;
+        slot.done = true;
+        if (cqe.res < 0 || static_cast<size_t>(cqe.res) < block_size)
+            short_read = true;
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+}
+
+#else
+
+bool specjson::IoUringInput::setup(unsigned Depth) {
+    return false;
+}
+
+void specjson::IoUringInput::queue() {
+}
+
+void specjson::IoUringInput::wait() noexcept(false) {
+}
+
+#endif
+
+size_t specjson::IoUringInput::fill(
+    char* Buffer, size_t Length, off_t Offset)
+{
+    size_t total = 0;
+    while (total < Length) {
+        ssize_t got = seekable ?
+            pread(fd, Buffer + total, Length - total, Offset + total) :
+            read(fd, Buffer + total, Length - total);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0) {
+            eof = true;
+            break;
+        }
+        total += static_cast<size_t>(got);
+        if (!seekable)
+            break; // Return what a pipe has now.
+    }
+    return total;
+}
+
+void specjson::IoUringInput::drain() noexcept(false) {
+    while (pending)
+        wait();
+}
+
+size_t specjson::IoUringInput::take(char* Buffer, size_t Length)
+    noexcept(false)
+{
+    queue();
+    if (!Uring())
+        return 0;
+    Slot& slot(slots[first]);
+    while (!slot.done)
+        wait();
+    if (slot.result <= 0) {
+        // End of file, or an error that pread reports again.
+        drain();
+        if (slot.result < 0)
+            teardown();
+        else
+            eof = true;
+        return 0;
+    }
+    size_t valid = static_cast<size_t>(slot.result);
+    size_t count = std::min(Length, valid - taken);
+    std::memcpy(Buffer,
+        static_cast<char*>(slot.vector.iov_base) + taken, count);
+    taken += count;
+    offset += count;
+    if (taken == valid) {
+        taken = 0;
+        if (valid < block_size) {
+            // Reads after a short one are dropped and queued again from here.
+            drain();
+            used = 0;
+            ahead = offset;
+            short_read = false;
+        } else {
+            first = (first + 1) % slots.size();
+            --used;
+        }
+    }
+    return count;
+}
+
+int specjson::IoUringInput::Read(char* Buffer, size_t Length) {
+    struct iovec vector;
+    vector.iov_base = Buffer;
+    vector.iov_len = Length;
+    return Read(&vector, 1);
+}
+
+int specjson::IoUringInput::Read(const struct iovec* Buffers, int Count) {
+    if (eof)
+        return 0;
+    if (!seekable) {
+        ssize_t got = readv(fd, Buffers, Count);
+        if (got <= 0) {
+            eof = got == 0 || errno != EINTR;
+            return 0;
+        }
+        return static_cast<int>(got);
+    }
+    size_t total = 0;
+    for (int k = 0; k < Count && !eof; ++k) {
+        size_t length = Buffers[k].iov_len;
+        char* buffer = static_cast<char*>(Buffers[k].iov_base);
+        size_t got = 0;
+        while (got < length && Uring() && !eof)
+            got += take(buffer + got, length - got);
+        if (got < length && !eof) {
+            size_t more = fill(buffer + got, length - got, offset);
+            offset += more;
+            got += more;
+        }
+        total += got;
+        if (got < length)
+            break;
+    }
+    return static_cast<int>(total);
+}
+
+bool specjson::IoUringInput::Ended() {
+    return eof;
+}
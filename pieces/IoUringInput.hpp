@@ -0,0 +1,64 @@
+extern const Exception IoUringFailed;
+
+// Reads a file with io_uring. Up to Depth reads of BlockSize bytes at
+// consecutive offsets are kept in flight ahead of the caller in internal
+// blocks, and Read copies the data out in file order and queues the next
+// reads, so the drive works while the caller parses. Falls back to pread when
+// io_uring is not available at build or run time, and to read when the file
+// descriptor is not seekable, such as a pipe.
+class IoUringInput : public InputChannel {
+private:
+    struct Slot {
+        struct iovec vector;
+        off_t at;
+        int result;
+        bool done;
+    };
+
+    int fd;
+    off_t offset;
+    bool seekable, eof;
+    int ring_fd;
+    unsigned entries;
+    void* sq_ring;
+    size_t sq_ring_size;
+    void* cq_ring;
+    size_t cq_ring_size;
+    void* sqes;
+    size_t sqes_size;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    void* cqes;
+    size_t block_size;
+    std::vector<char> blocks;
+    std::vector<Slot> slots;
+    unsigned first, used, pending;
+    size_t taken;
+    off_t ahead;
+    bool short_read;
+
+    bool setup(unsigned Depth);
+    void teardown();
+    void queue();
+    void wait() noexcept(false);
+    void drain() noexcept(false);
+    size_t take(char* Buffer, size_t Length) noexcept(false);
+    size_t fill(char* Buffer, size_t Length, off_t Offset);
+
+public:
+    // Depth is the most reads in flight. UseUring false forces pread.
+    IoUringInput(int FileDescriptor, unsigned Depth = 8, bool UseUring = true,
+        size_t BlockSize = 1048576);
+    IoUringInput(const IoUringInput&) = delete;
+    IoUringInput& operator=(const IoUringInput&) = delete;
+    ~IoUringInput();
+
+    bool Uring() const { return 0 <= ring_fd; }
+    int Read(char* Buffer, size_t Length);
+    int Read(const struct iovec* Buffers, int Count);
+    bool Ended();
+};
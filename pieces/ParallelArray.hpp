@@ -0,0 +1,88 @@
+// Parses items in [Begin, End) and appends them to Out. End must point to the
+// ',' or ']' that follows the last item.
+template<typename Parser>
+void parse_array_segment(const char* Begin, const char* End,
+    std::vector<typename Parser::Type>& Out) noexcept(false)
+{
+    const char* origin = Begin;
+    ParserPool pool;
+    Parser& p(std::get<Parser::Pool::Index>(pool.Parser));
+    typename Parser::Type& value(std::get<Parser::Pool::Index>(pool.Value));
+    // The character at End terminates numbers and whitespace skip.
+    const char* end = End + 1;
+    while (true) {
+        Begin = p.Parse(pool.skipWhitespace(Begin, end), end, pool);
+        if (Begin == nullptr)
+            throw NotFinished;
+        Out.push_back(value);
+        Begin = pool.skipWhitespace(Begin, end);
+        if (Begin == End)
+            return;
+        if (*Begin != ',')
+            throw ContextException(InvalidArraySeparator, origin, Begin, End);
+        ++Begin;
+    }
+}
+
+// Splits the array contents [Begin, End) at commas into Threads parts that
+// are parsed in parallel, then appends the items to Out in order. End must
+// point to the closing ']'.
+template<typename Parser>
+void parse_array_parallel(const char* Begin, const char* End,
+    std::vector<typename Parser::Type>& Out, unsigned Threads) noexcept(false)
+{
+    std::vector<const char*> starts;
+    starts.push_back(Begin);
+    const size_t length = End - Begin;
+    for (unsigned k = 1; k < Threads; ++k) {
+        const char* split = Begin + length * k / Threads;
+        if (split < starts.back())
+            continue;
+        split = static_cast<const char*>(std::memchr(split, ',', End - split));
+        if (split == nullptr)
+            break;
+        starts.push_back(split + 1);
+    }
+    starts.push_back(End + 1);
+    const size_t count = starts.size() - 1;
+    std::vector<std::vector<typename Parser::Type>> parts(count);
+    std::vector<std::exception_ptr> errors(count);
+    auto segment = [&starts, &parts, &errors](size_t Index) {
+        try {
+            parse_array_segment<Parser>(
+                starts[Index], starts[Index + 1] - 1, parts[Index]);
+        }
+        catch (...) {
+            errors[Index] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k < count; ++k)
+        workers.push_back(std::thread(segment, k));
+    segment(0);
+    for (auto& worker : workers)
+        worker.join();
+    size_t total = Out.size();
+    for (size_t k = 0; k < count; ++k) {
+        if (errors[k])
+            std::rethrow_exception(errors[k]);
+        total += parts[k].size();
+    }
+    Out.reserve(total);
+    for (auto& part : parts)
+        Out.insert(Out.end(), part.begin(), part.end());
+}
+
+// Makes P parse arrays of numbers that are entirely in the buffer and at least
+// Threshold bytes long in parallel. Threads 0 uses the hardware concurrency
+// and 1 turns parallel parsing off.
+template<typename Parser>
+void EnableParallel(ParseStdVector<Parser>& P,
+    size_t Threshold = 1048576, unsigned Threads = 0)
+{
+    static_assert(std::is_arithmetic<typename Parser::Type>::value,
+        "Parallel parsing is for arrays of numbers.");
+    if (Threads == 0)
+        Threads = std::thread::hardware_concurrency();
+    P.SetParallel(&parse_array_parallel<Parser>, Threshold, Threads);
+}
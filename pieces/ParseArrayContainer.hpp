@@ -3,112 +3,110 @@ extern const Exception InvalidArrayStart;
 extern const Exception InvalidArraySeparator;
 extern const Exception SubContainerSizeVaries;
 
-template<typename Container, typename Parser, bool Swaps = false>
-class ParseArray : public ValueParser {
-public:
-    typedef Container Type;
+// Common part of the array parsers: expects '[', parses the items separated
+// by ',' and continues where the previous buffer ended.
+class ParseArrayItems : public ValueParser {
+protected:
+    bool began, expect_item;
 
-private:
-    Type out;
-    bool began, expect_number;
+    ParseArrayItems() : began(false), expect_item(true) { }
 
-public:
-    ParseArray() : began(false), expect_number(true) { }
-    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+    // Parses items using P and calls Store() after each one. Close(Endptr)
+    // is called with the position after ']' and returns what Parse returns.
+    // Empty tells whether no item has been stored yet.
+    template<typename ItemParser, typename Store, typename Close>
+    const char* parse_items(const char* Begin, const char* End,
+        ParserPool& Pool, ItemParser& P, bool Empty, Store&& S, Close&& C)
         noexcept(false);
-
-    void Swap(Type& Alt) {
-        if (!Finished())
-            throw NotFinished;
-        std::swap(Alt, out);
-        out.resize(0);
-    }
 };
 
-template<typename Container, typename Parser, bool Swaps>
-const char* ParseArray<Container,Parser,Swaps>::Parse(
-    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+template<typename ItemParser, typename Store, typename Close>
+const char* ParseArrayItems::parse_items(const char* Begin, const char* End,
+    ParserPool& Pool, ItemParser& P, bool Empty, Store&& S, Close&& C)
+    noexcept(false)
 {
     const char* origin = Begin;
-    Parser& p(std::get<Parser::Pool::Index>(Pool.Parser));
-    typename Parser::Type& value(std::get<Parser::Pool::Index>(Pool.Value));
-    if (!p.Finished()) {
+    if (!P.Finished()) {
         // In the middle of parsing value when buffer ended?
-        Begin = p.Parse(Begin, End, Pool);
+        Begin = P.Parse(Begin, End, Pool);
         if (Begin == nullptr)
             return setFinished(nullptr);
-        if constexpr (Swaps) {
-            out.push_back(typename Parser::Type());
-            p.Swap(out.back());
-        } else
-            out.push_back(value);
-        expect_number = false;
+        S();
+        expect_item = false;
     } else if (!began) {
         // Expect '[' on first call.
         if (*Begin != '[')
             throw ContextException(InvalidArrayStart, origin, Begin, End);
-        began = expect_number = true;
+        began = expect_item = true;
         Begin = skipWhitespace(++Begin, End);
-        if (Begin == nullptr || !*Begin)
+        if (Begin == nullptr)
             return setFinished(nullptr);
         if (*Begin == ']') {
             began = false; // In case caller re-uses. Out must be empty.
-            return setFinished(++Begin);
+            return C(++Begin);
         }
-    } else if (out.empty()) {
+    } else if (Empty) {
         Begin = skipWhitespace(Begin, End);
-        if (Begin == nullptr || !*Begin)
+        if (Begin == nullptr)
             return setFinished(nullptr);
         if (*Begin == ']') {
             began = false; // In case caller re-uses. Out must be empty.
-            return setFinished(++Begin);
+            return C(++Begin);
         }
     }
     while (Begin != End) {
-        if (expect_number) {
+        if (expect_item) {
             Begin = skipWhitespace(Begin, End);
-            if (Begin == nullptr || !*Begin)
+            if (Begin == nullptr)
                 return setFinished(nullptr);
             // Now there should be the item to parse.
-            Begin = p.Parse(Begin, End, Pool);
+            Begin = P.Parse(Begin, End, Pool);
             if (Begin == nullptr)
                 return setFinished(nullptr);
-            out.push_back(value);
-            expect_number = false;
+            S();
+            expect_item = false;
         }
         // Comma, maybe surrounded by spaces.
-        if (*Begin == ',') // Most likely unless prettified.
+        if (Begin != End && *Begin == ',') // Most likely unless prettified.
             ++Begin;
         else {
             Begin = skipWhitespace(Begin, End);
-            if (Begin == nullptr || !*Begin)
+            if (Begin == nullptr)
                 return setFinished(nullptr);
             if (*Begin == ']') {
                 began = false;
-                return setFinished(++Begin);
+                return C(++Begin);
             }
             if (*Begin != ',')
                 throw ContextException(InvalidArraySeparator, origin, Begin, End);
             Begin++;
         }
-        expect_number = true;
+        expect_item = true;
     }
     return setFinished(nullptr);
 }
 
 
-template<typename Container, typename Parser, bool SameSize = false>
-class ParseContainerArray : public ValueParser {
+template<typename Container, typename Parser, bool Swaps = false>
+class ParseArray : public ParseArrayItems {
 public:
     typedef Container Type;
 
-private:
-    Parser p;
+protected:
     Type out;
-    bool began, expect_item;
+
+    // Moves values that own memory out of the pool, copies others.
+    void store(Parser& P, typename Parser::Type& Value) {
+        if constexpr (Swaps) {
+            out.push_back(typename Parser::Type());
+            P.Swap(out.back());
+        } else if constexpr (std::is_trivially_copyable<typename Parser::Type>::value)
+            out.push_back(Value);
+        else
+            out.push_back(std::move(Value));
+    }
 
 public:
-    ParseContainerArray() : began(false), expect_item(true) { }
     const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
         noexcept(false);
 
@@ -120,78 +118,51 @@ public:
     }
 };
 
-
-template<typename Container, typename Parser, bool SameSize>
-const char* ParseContainerArray<Container,Parser,SameSize>::Parse(
+template<typename Container, typename Parser, bool Swaps>
+const char* ParseArray<Container,Parser,Swaps>::Parse(
     const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
 {
-    const char* origin = Begin;
-    if (!p.Finished()) {
-        // In the middle of parsing value when buffer ended?
-        Begin = p.Parse(Begin, End, Pool);
-        if (Begin == nullptr)
-            return setFinished(nullptr);
+    Parser& p(std::get<Parser::Pool::Index>(Pool.Parser));
+    typename Parser::Type& value(std::get<Parser::Pool::Index>(Pool.Value));
+    return parse_items(Begin, End, Pool, p, out.empty(),
+        [&]() { store(p, value); },
+        [this](const char* Endptr) { return setFinished(Endptr); });
+}
+
+
+template<typename Container, typename Parser, bool SameSize = false>
+class ParseContainerArray : public ParseArrayItems {
+public:
+    typedef Container Type;
+
+private:
+    Parser p;
+
+    void store() {
         out.push_back(typename Parser::Type());
         p.Swap(out.back());
         if constexpr (SameSize) {
             if (out.front().size() != out.back().size())
                 throw SubContainerSizeVaries;
         }
-        expect_item = false;
-    } else if (!began) {
-        // Expect '[' on first call.
-        if (*Begin != '[')
-            throw ContextException(InvalidArrayStart, origin, Begin, End);
-        began = expect_item = true;
-        Begin = skipWhitespace(++Begin, End);
-        if (Begin == nullptr || !*Begin)
-            return setFinished(nullptr);
-        if (*Begin == ']') {
-            began = false; // In case caller re-uses. Out must be empty.
-            return setFinished(++Begin);
-        }
-    } else if (out.empty()) {
-        Begin = skipWhitespace(Begin, End);
-        if (Begin == nullptr || !*Begin)
-            return setFinished(nullptr);
-        if (*Begin == ']') {
-            began = false; // In case caller re-uses. Out must be empty.
-            return setFinished(++Begin);
-        }
     }
-    while (Begin != End) {
-        if (expect_item) {
-            Begin = skipWhitespace(Begin, End);
-            if (Begin == nullptr || !*Begin)
-                return setFinished(nullptr);
-            // Now there should be the item to parse.
-            Begin = p.Parse(Begin, End, Pool);
-            if (Begin == nullptr)
-                return setFinished(nullptr);
-            out.push_back(typename Parser::Type());
-            p.Swap(out.back());
-            if constexpr (SameSize) {
-                if (out.front().size() != out.back().size())
-                    throw SubContainerSizeVaries;
-            }
-            expect_item = false;
-        }
-        // Comma, maybe surrounded by spaces.
-        if (*Begin == ',') // Most likely unless prettified.
-            ++Begin;
-        else {
-            Begin = skipWhitespace(Begin, End);
-            if (Begin == nullptr || !*Begin)
-                return setFinished(nullptr);
-            if (*Begin == ']') {
-                began = false;
-                return setFinished(++Begin);
-            }
-            if (*Begin != ',')
-                throw ContextException(InvalidArraySeparator, origin, Begin, End);
-            Begin++;
-        }
-        expect_item = true;
+
+protected:
+    Type out;
+
+public:
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false)
+    {
+        return parse_items(Begin, End, Pool, p, out.empty(),
+            [this]() { store(); },
+            [this](const char* Endptr) { return setFinished(Endptr); });
     }
-    return setFinished(nullptr);
-}
+
+    void Swap(Type& Alt) {
+        if (!Finished())
+            throw NotFinished;
+        std::swap(Alt, out);
+        out.resize(0);
+    }
+};
@@ -0,0 +1,37 @@
+// Parses an array of objects into Columns. Columns must have push_back that
+// takes the parsed object values, and empty and resize methods.
+template<typename Columns, typename Parser>
+class ParseColumnArray : public ParseArrayItems {
+public:
+    typedef Columns Type;
+
+private:
+    Parser p;
+    typename Parser::Type record;
+    Type out;
+
+    void store() {
+        p.Swap(record);
+        out.push_back(record);
+    }
+
+public:
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+
+    void Swap(Type& Alt) {
+        if (!Finished())
+            throw NotFinished;
+        std::swap(Alt, out);
+        out.resize(0);
+    }
+};
+
+template<typename Columns, typename Parser>
+const char* ParseColumnArray<Columns,Parser>::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    return parse_items(Begin, End, Pool, p, out.empty(),
+        [this]() { store(); },
+        [this](const char* Endptr) { return setFinished(Endptr); });
+}
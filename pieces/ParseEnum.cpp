@@ -0,0 +1 @@
+const Exception specjson::InvalidEnum("String not one of the allowed values.");
@@ -0,0 +1,43 @@
+extern const Exception InvalidEnum;
+
+// Lookup sets the value that matches the string or returns false.
+template<typename Enum, bool (*Lookup)(const char*, const char*, Enum&)>
+class ParseEnum : public ValueParser {
+public:
+    typedef Enum Type;
+
+private:
+    Type out;
+
+public:
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+
+    void Swap(Type& Alt) { Alt = out; }
+};
+
+template<typename Enum, bool (*Lookup)(const char*, const char*, Enum&)>
+const char* ParseEnum<Enum,Lookup>::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    ParseString& p(std::get<ParseString::Pool::Index>(Pool.Parser));
+    if (p.Finished() && *Begin == '"') {
+        // Strings without escapes are compared in the input buffer.
+        for (const char* curr = Begin + 1; curr != End; ++curr) {
+            if (*curr == '"') {
+                if (!Lookup(Begin + 1, curr, out))
+                    throw ContextException(InvalidEnum, Begin, curr, End);
+                return setFinished(curr + 1);
+            }
+            if (*curr == '\\' || static_cast<unsigned char>(*curr) < 32)
+                break;
+        }
+    }
+    Begin = p.Parse(Begin, End, Pool);
+    if (Begin == nullptr)
+        return setFinished(nullptr);
+    const std::string& value(std::get<ParseString::Pool::Index>(Pool.Value));
+    if (!Lookup(value.data(), value.data() + value.size(), out))
+        throw InvalidEnum;
+    return setFinished(Begin);
+}
@@ -0,0 +1,45 @@
+const Exception specjson::FileOpenFailed("Failed to open file.");
+const Exception specjson::FileReadFailed("Failed to read file.");
+const Exception specjson::FileEndedEarly("File ended before value.");
+
+specjson::FileMapping::FileMapping(int FD) : data(nullptr), size(0) {
+    struct stat info;
+    if (fstat(FD, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0)
+        return;
+    size_t length = static_cast<size_t>(info.st_size);
+    void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, FD, 0);
+    if (addr == MAP_FAILED)
+        return;
+    madvise(addr, length, MADV_SEQUENTIAL);
+#if defined(MADV_HUGEPAGE)
+    madvise(addr, length, MADV_HUGEPAGE);
+#endif
+    data = static_cast<const char*>(addr);
+    size = length;
+}
+
+specjson::FileMapping::~FileMapping() {
+    if (data != nullptr)
+        munmap(const_cast<char*>(data), size);
+}
+
+specjson::FileDescriptor::FileDescriptor(const char* Filename)
+    : fd(open(Filename, O_RDONLY))
+{
+    if (fd < 0)
+        throw FileOpenFailed;
+}
+
+specjson::FileDescriptor::~FileDescriptor() {
+    close(fd);
+}
+
+size_t specjson::read_block(int FD, char* Buffer, size_t Size) {
+    while (true) {
+        ssize_t count = read(FD, Buffer, Size);
+        if (0 <= count)
+            return static_cast<size_t>(count);
+        if (errno != EINTR)
+            throw FileReadFailed;
+    }
+}
@@ -0,0 +1,76 @@
+extern const Exception FileOpenFailed;
+extern const Exception FileReadFailed;
+extern const Exception FileEndedEarly;
+
+// Read-only mapping of a whole regular file. Data is nullptr when the file
+// could not be mapped, such as when it is a pipe or empty.
+class FileMapping {
+private:
+    const char* data;
+    size_t size;
+
+public:
+    FileMapping(int FD);
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+    ~FileMapping();
+
+    const char* Data() const { return data; }
+    size_t Size() const { return size; }
+};
+
+// Closes the descriptor when out of scope.
+class FileDescriptor {
+private:
+    int fd;
+
+public:
+    FileDescriptor(const char* Filename) noexcept(false);
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    ~FileDescriptor();
+
+    int FD() const { return fd; }
+};
+
+// Reads up to Size bytes. Returns 0 at end of file, throws on error.
+size_t read_block(int FD, char* Buffer, size_t Size) noexcept(false);
+
+// Parses the contents of FD using P. Regular files are mapped and parsed in
+// one call, others are read in blocks of BlockSize. Throws if the file ends
+// before the value. Values that refer to the input, such as StringView, are
+// not valid after return, and InSituString can not be used.
+template<typename Parser>
+void ParseFile(int FD, Parser& P, ParserPool& Pool,
+    size_t BlockSize = 1048576) noexcept(false)
+{
+    FileMapping mapping(FD);
+    if (mapping.Data() != nullptr) {
+        const char* end = mapping.Data() + mapping.Size();
+        // Whitespace before the value.
+        const char* begin = Pool.skipWhitespace(mapping.Data(), end);
+        if (begin != nullptr && P.Parse(begin, end, Pool))
+            return;
+        throw FileEndedEarly;
+    }
+    std::vector<char> block(BlockSize);
+    while (size_t count = read_block(FD, block.data(), BlockSize)) {
+        const char* begin = block.data();
+        if (P.Finished()) {
+            begin = Pool.skipWhitespace(begin, block.data() + count);
+            if (begin == nullptr)
+                continue;
+        }
+        if (P.Parse(begin, block.data() + count, Pool))
+            return;
+    }
+    throw FileEndedEarly;
+}
+
+template<typename Parser>
+void ParseFile(const char* Filename, Parser& P, ParserPool& Pool,
+    size_t BlockSize = 1048576) noexcept(false)
+{
+    FileDescriptor file(Filename);
+    ParseFile(file.FD(), P, Pool, BlockSize);
+}
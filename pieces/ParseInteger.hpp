@@ -28,23 +28,31 @@ const char* parse_integer(T& Out, const char* Begin, const char* End,
     std::vector<char>& Buffer, bool Finished)
     noexcept(false)
 {
+    auto integer_char = [](const char C) {
+        return ('0' <= C && C <= '9') || C == '-' || C == '+';
+    };
     char* end = nullptr;
     if (Finished) {
+        if (Begin == End)
+            return nullptr;
+        // Find the end of the number so that conversion stays before End.
+        const char* stop = Begin;
+        while (stop != End && integer_char(*stop))
+            ++stop;
+        if (stop == End) {
+            // It is possible the number continues in next buffer.
+            Buffer.insert(Buffer.end(), Begin, End);
+            return nullptr;
+        }
+        if (stop == Begin)
+            throw InvalidInt;
         Out = convert_to_integer<T,Minimum,Maximum>(Begin, &end);
-        if (end == Begin) {
-            if (Begin == End)
-                return nullptr;
-            // Unless only sign fit, throw.
-            if (Begin + 1 != End || (*Begin != '-' && *Begin != '+'))
-                throw InvalidInt;
-        } else if (end != End)
-            return end; // Good up to this.
-        while (Begin != End)
-            Buffer.push_back(*Begin++);
-        return nullptr;
+        if (end != stop)
+            throw InvalidInt;
+        return end; // Good up to this.
     }
-    // Start of the number is in buffer. Input is null-terminated.
-    while (('0' <= *Begin && *Begin <= '9') || *Begin == '-' || *Begin == '+')
+    // Start of the number is in buffer.
+    while (Begin != End && integer_char(*Begin))
         Buffer.push_back(*Begin++);
     if (Begin == End) // Continues on and on?
         return nullptr;
@@ -73,6 +73,8 @@ public:
         return p;
     }
 
+    Parser& Contained() { return p; }
+
     bool Required() const { return false; }
 };
 
@@ -87,7 +89,7 @@ class RequiredKeyContainerValue : public KeyContainerValue<KeyString,Parser> {
 template<class ... Fields>
 class KeyValues {
 private:
-    std::vector<ScanningKeyValue*> ptrs;
+    std::array<ScanningKeyValue*, sizeof...(Fields)> ptrs;
 
     template<typename FuncObj, typename Tuple, size_t... IdxSeq>
     void apply_to_each(FuncObj&& fo, Tuple&& t, std::index_sequence<IdxSeq...>)
@@ -100,17 +102,17 @@ private:
 
     class Pusher {
     private:
-        std::vector<ScanningKeyValue*>& tgt;
+        ScanningKeyValue** tgt;
     public:
-        Pusher(std::vector<ScanningKeyValue*>& Target) : tgt(Target) { }
-        void operator()(ScanningKeyValue& SKV) { tgt.push_back(&SKV); }
+        Pusher(ScanningKeyValue** Target) : tgt(Target) { }
+        void operator()(ScanningKeyValue& SKV) { *tgt++ = &SKV; }
     };
 
 public:
     std::tuple<Fields...> fields;
 
     KeyValues() {
-        Pusher psh(ptrs);
+        Pusher psh(ptrs.data());
         apply_to_each(psh, fields,
             std::make_index_sequence<std::tuple_size<decltype(fields)>::value>
                 {});
@@ -139,17 +141,44 @@ public:
     bool Given() const { return given; }
 };
 
+template<typename T, typename = void>
+struct HasClear : std::false_type { };
+
+template<typename T>
+struct HasClear<T, std::void_t<decltype(std::declval<T&>().clear())>>
+    : std::true_type { };
+
+// Empties V but keeps the memory it owns, when it has a clear method.
+template<typename T>
+void clear_value(T& V) {
+    if constexpr (HasClear<T>::value)
+        V.clear();
+    else
+        V = T();
+}
+
+template<typename ... Fields>
+void clear_value(std::tuple<Fields...>& V) {
+    std::apply([](auto& ... F) { (F.Reset(), ...); }, V);
+}
+
 template<typename Parser>
 class Value : public ValueStore {
 public:
     typedef typename Parser::Type Type;
     Type value;
+
+    // Marks the value as not given and empties it for re-use.
+    void Reset() {
+        given = false;
+        clear_value(value);
+    }
 };
 
 template<class ... Fields>
 class NamelessValues {
 private:
-    std::vector<ValueStore*> ptrs;
+    std::array<ValueStore*, sizeof...(Fields)> ptrs;
 
     template<typename FuncObj, typename Tuple, size_t... IdxSeq>
     void apply_to_each(FuncObj&& fo, Tuple&& t, std::index_sequence<IdxSeq...>)
@@ -162,17 +191,17 @@ private:
 
     class Pusher {
     private:
-        std::vector<ValueStore*>& tgt;
+        ValueStore** tgt;
     public:
-        Pusher(std::vector<ValueStore*>& Target) : tgt(Target) { }
-        void operator()(ValueStore& VS) { tgt.push_back(&VS); }
+        Pusher(ValueStore** Target) : tgt(Target) { }
+        void operator()(ValueStore& VS) { *tgt++ = &VS; }
     };
 
 public:
     std::tuple<Fields...> fields;
 
     NamelessValues() {
-        Pusher psh(ptrs);
+        Pusher psh(ptrs.data());
         apply_to_each(psh, fields, std::make_index_sequence<std::tuple_size<decltype(fields)>::value> {});
     }
 
@@ -200,9 +229,11 @@ void KeyContainerValue<KeyString,Parser>::Swap(ValueStore* VS, ParserPool& Pool)
 
 template<typename KeyValues, typename Values>
 class ParseObject : public ValueParser {
-private:
+protected:
     KeyValues parsers;
     Values out;
+
+private:
     int activating, active;
     enum State {
         NotStarted,
@@ -251,6 +282,17 @@ public:
         std::swap(Alt, out.fields);
         out.fields = Type();
     }
+
+    // Like Swap but Alt is emptied and kept for the next object, so the memory
+    // that its strings and arrays own is re-used. Used by ParseSequence.
+    void SwapReuse(Type& Alt) {
+        std::swap(Alt, out.fields);
+        clear_value(out.fields);
+    }
+
+    // Parser of a field with container value, to set it up before parsing.
+    template<size_t Index>
+    auto& FieldParser() { return std::get<Index>(parsers.fields).Contained(); }
 };
 
 template<typename KeyValues, typename Values>
@@ -268,7 +310,7 @@ const char* ParseObject<KeyValues,Values>::Parse(
             ++Begin;
         case PreKey:
             Begin = skipWhitespace(Begin, End);
-            if (Begin == nullptr || !*Begin)
+            if (Begin == nullptr)
                 return setFinished(nullptr);
             if (*Begin == '}')
                 return checkPassed(++Begin);
@@ -282,7 +324,7 @@ const char* ParseObject<KeyValues,Values>::Parse(
             state = PreColon;
         case PreColon:
             Begin = skipWhitespace(Begin, End);
-            if (Begin == nullptr || !*Begin)
+            if (Begin == nullptr)
                 return setFinished(nullptr);
             state = ExpectColon;
         case ExpectColon:
@@ -293,7 +335,7 @@ const char* ParseObject<KeyValues,Values>::Parse(
                 return setFinished(nullptr);
         case PreValue:
             Begin = skipWhitespace(Begin, End);
-            if (Begin == nullptr || !*Begin)
+            if (Begin == nullptr)
                 return setFinished(nullptr);
             active = activating;
             activating = -1;
@@ -307,7 +349,7 @@ const char* ParseObject<KeyValues,Values>::Parse(
             state = PreComma;
         case PreComma:
             Begin = skipWhitespace(Begin, End);
-            if (Begin == nullptr || !*Begin)
+            if (Begin == nullptr)
                 return setFinished(nullptr);
             state = ExpectComma;
         case ExpectComma:
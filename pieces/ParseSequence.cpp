@@ -0,0 +1 @@
+const Exception specjson::SequenceEndedEarly("Input ended in a value.");
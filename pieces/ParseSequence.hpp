@@ -0,0 +1,69 @@
+extern const Exception SequenceEndedEarly;
+
+// Parses a sequence of values separated by whitespace, such as JSON Lines,
+// given in chunks of any size. Each value is passed to a callback when it is
+// finished. The same parser and value are used for all values, so the memory
+// that the value owns is re-used for the next one.
+template<typename Parser>
+class ParseSequence {
+public:
+    typedef typename Parser::Type Type;
+    typedef std::function<void(Type& Value)> Callback;
+
+private:
+    Parser p;
+    Type value;
+    Callback callback;
+    size_t count;
+
+public:
+    ParseSequence(Callback CB) : callback(CB), count(0) { }
+
+    // Parses all values in the chunk. A value that continues past End is
+    // finished by the next call.
+    void Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+
+    // Parses values until the input of Stream ends. Throws if the input ends
+    // in the middle of a value. Stream has Next(Begin, End) that gives the
+    // next chunk and returns false at the end, such as StreamParser.
+    template<typename Stream>
+    void Parse(Stream& S, ParserPool& Pool) noexcept(false) {
+        const char* begin;
+        const char* end;
+        while (S.Next(begin, end))
+            Parse(begin, end, Pool);
+        Finish();
+    }
+
+    // Throws if the last chunk ended in the middle of a value.
+    void Finish() noexcept(false) {
+        if (!p.Finished())
+            throw SequenceEndedEarly;
+    }
+
+    // Number of values passed to the callback.
+    size_t Count() const { return count; }
+    // For setting up the parser, such as the FieldParser callbacks.
+    Parser& Contained() { return p; }
+};
+
+template<typename Parser>
+void ParseSequence<Parser>::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    while (Begin != End) {
+        if (p.Finished()) {
+            // Newline or other whitespace between values.
+            Begin = Pool.skipWhitespace(Begin, End);
+            if (Begin == nullptr)
+                return;
+        }
+        Begin = p.Parse(Begin, End, Pool);
+        if (Begin == nullptr)
+            return;
+        p.SwapReuse(value);
+        ++count;
+        callback(value);
+    }
+}
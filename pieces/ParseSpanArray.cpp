@@ -0,0 +1 @@
+const Exception specjson::SpanCapacityExceeded("Array exceeds target capacity.");
@@ -0,0 +1,60 @@
+extern const Exception SpanCapacityExceeded;
+
+// Fixed-capacity view to memory owned by the caller.
+template<typename T>
+class Span {
+private:
+    T* items;
+    size_t count, capacity;
+
+public:
+    Span() : items(nullptr), count(0), capacity(0) { }
+    Span(T* Items, size_t Capacity)
+        : items(Items), count(0), capacity(Capacity) { }
+
+    void push_back(const T& Item) {
+        if (count == capacity)
+            throw SpanCapacityExceeded;
+        items[count++] = Item;
+    }
+
+    void resize(size_t Size) {
+        if (capacity < Size)
+            throw SpanCapacityExceeded;
+        count = Size;
+    }
+
+    T* data() { return items; }
+    const T* data() const { return items; }
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+    T& operator[](size_t Index) { return items[Index]; }
+    const T& operator[](size_t Index) const { return items[Index]; }
+    size_t size() const { return count; }
+    size_t max_size() const { return capacity; }
+    bool empty() const { return count == 0; }
+};
+
+// Parses an array of scalars directly into memory given using Target.
+// Throws if the array has more items than fit. Swap gives the filled Span
+// and clears the target, so set a new target before parsing next array.
+template<typename Parser>
+class ParseSpanArray
+    : public ParseArray<Span<typename Parser::Type>, Parser, false>
+{
+public:
+    typedef Span<typename Parser::Type> Type;
+
+    void Target(typename Parser::Type* Items, size_t Capacity) {
+        this->out = Type(Items, Capacity);
+    }
+
+    void Swap(Type& Alt) {
+        if (!this->Finished())
+            throw NotFinished;
+        Alt = this->out;
+        this->out = Type();
+    }
+};
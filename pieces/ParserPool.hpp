@@ -1,11 +1,29 @@
 class ParserPool {
 public:
-    ParserPool() { }
+    ParserPool()
+        : Stats(nullptr), writable_begin(nullptr), writable_end(nullptr) { }
     ParserPool(const ParserPool&) = delete;
     ParserPool& operator=(const ParserPool&) = delete;
     virtual ~ParserPool();
 
     std::vector<char> buffer;
+    // Set to collect memory use when specification has stats enabled.
+    AllocationStats* Stats;
+
+    // Marks input that the caller owns and allows parsers, such as
+    // InSituString, to modify. Input outside the range is not modified.
+    void SetWritable(char* Begin, char* End) {
+        writable_begin = Begin;
+        writable_end = End;
+    }
+    // Returns Begin as modifiable if [Begin, End) is in the writable range.
+    char* Writable(const char* Begin, const char* End) const {
+        std::less_equal<const char*> le;
+        if (writable_begin == nullptr ||
+            !le(writable_begin, Begin) || !le(End, writable_end))
+            return nullptr;
+        return writable_begin + (Begin - writable_begin);
+    }
 
     enum Parsers { PoolIndexes };
     std::tuple<PoolParsers> Parser;
@@ -17,4 +35,8 @@ public:
     inline bool isWhitespace(const char C) {
         return std::get<0>(Parser).isWhitespace(C);
     }
+
+private:
+    char* writable_begin;
+    char* writable_end;
 };
@@ -0,0 +1,15 @@
+static thread_local std::pmr::memory_resource* pmr_resource = nullptr;
+
+std::pmr::memory_resource* specjson::PmrResource() {
+    return pmr_resource ? pmr_resource : std::pmr::get_default_resource();
+}
+
+specjson::PmrScope::PmrScope(std::pmr::memory_resource* Resource)
+    : previous(pmr_resource)
+{
+    pmr_resource = Resource;
+}
+
+specjson::PmrScope::~PmrScope() {
+    pmr_resource = previous;
+}
@@ -0,0 +1,60 @@
+// Memory resource that default-constructed PmrString and PmrVector use.
+// Returns std::pmr::get_default_resource() outside PmrScope.
+std::pmr::memory_resource* PmrResource();
+
+// Sets PmrResource for the current thread while in scope. Create the parsed
+// objects and parse them inside the scope, for example with a
+// std::pmr::monotonic_buffer_resource that is released after the values.
+class PmrScope {
+private:
+    std::pmr::memory_resource* previous;
+
+public:
+    PmrScope(std::pmr::memory_resource* Resource);
+    PmrScope(const PmrScope&) = delete;
+    PmrScope& operator=(const PmrScope&) = delete;
+    ~PmrScope();
+};
+
+class PmrString : public std::pmr::string {
+public:
+    using std::pmr::string::basic_string;
+    PmrString() : std::pmr::string(PmrResource()) { }
+    PmrString(const PmrString& S) : std::pmr::string(S, PmrResource()) { }
+    PmrString(PmrString&& S) = default;
+    PmrString& operator=(const PmrString& S) = default;
+    PmrString& operator=(PmrString&& S) = default;
+};
+
+template<typename T>
+class PmrVector : public std::pmr::vector<T> {
+public:
+    using std::pmr::vector<T>::vector;
+    PmrVector() : std::pmr::vector<T>(PmrResource()) { }
+    PmrVector(const PmrVector& V) : std::pmr::vector<T>(V, PmrResource()) { }
+    PmrVector(PmrVector&& V) = default;
+    PmrVector& operator=(const PmrVector& V) = default;
+    PmrVector& operator=(PmrVector&& V) = default;
+};
+
+// Re-creates Value if it uses another resource than PmrResource. Contents
+// are lost so call only when Value will be overwritten.
+template<typename T>
+void pmr_rebind(T& Value) {
+    if (Value.get_allocator().resource() != PmrResource()) {
+        Value.~T();
+        new (&Value) T();
+    }
+}
+
+template<typename Sink>
+void Write(Sink& S, const std::pmr::string& Value, std::vector<char>& Buffer) {
+    Write(S, Value.c_str(), Value.c_str() + Value.size(), Buffer);
+}
+
+template<typename Sink, typename T>
+void Write(Sink& S, const std::pmr::vector<T>& Value, std::vector<char>& Buffer) {
+    auto b = Value.cbegin();
+    auto e = Value.cend();
+    Write<Sink,typename std::pmr::vector<T>::const_iterator>(S, b, e, Buffer);
+}
@@ -0,0 +1,58 @@
+//
+//  StreamParser.cpp
+//  specificjson
+//
+//  Copyright © 2020-2022 Ismo Kärkkäinen. All rights reserved.
+//
+// Licensed under Universal Permissive License. See License.txt.
+
+const Exception specjson::StreamEndedEarly("Input ended before value.");
+
+specjson::StreamParser::StreamParser(InputChannel& Input,
+    size_t BlockSize, size_t BlocksPerRead, size_t Blocks, bool HugePages)
+    : input(Input), blocks_per_read(BlocksPerRead ? BlocksPerRead : 1),
+    ring(Blocks, BlockSize, HugePages), position(nullptr), end(nullptr),
+    stopping(false), reader(&StreamParser::read, this)
+{ }
+
+specjson::StreamParser::~StreamParser() {
+    stopping = true;
+    ring.Stop();
+    reader.join();
+}
+
+void specjson::StreamParser::read() {
+    try {
+        std::vector<struct iovec> vectors(blocks_per_read);
+        while (!stopping && !input.Ended()) {
+            size_t count = ring.Acquire(vectors.data(), vectors.size());
+            if (count == 0)
+                break;
+            int got = input.Read(vectors.data(), static_cast<int>(count));
+            ring.Publish(0 < got ? static_cast<size_t>(got) : 0);
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    ring.End();
+}
+
+bool specjson::StreamParser::next() {
+    if (!ring.Next(position, end)) {
+        position = end = nullptr;
+        if (error)
+            std::rethrow_exception(error);
+        return false;
+    }
+    return true;
+}
+
+bool specjson::StreamParser::Next(const char*& Begin, const char*& End) {
+    if (position == end && !next())
+        return false;
+    Begin = position;
+    End = end;
+    position = end;
+    return true;
+}
@@ -0,0 +1,74 @@
+//
+//  StreamParser.hpp
+//  specificjson
+//
+//  Copyright © 2020-2022 Ismo Kärkkäinen. All rights reserved.
+//
+// Licensed under Universal Permissive License. See License.txt.
+
+extern const Exception StreamEndedEarly;
+
+// Reads Input into a ring of blocks in a background thread while Parse parses
+// the blocks that have already been read, so reading and parsing overlap.
+// Values that refer to the input, such as StringView, are not valid after
+// the block is recycled, so do not use them with this.
+class StreamParser {
+private:
+    InputChannel& input;
+    size_t blocks_per_read;
+    BlockRing ring;
+    const char* position;
+    const char* end;
+    std::atomic<bool> stopping;
+    std::exception_ptr error;
+    std::thread reader;
+
+    void read();
+    bool next() noexcept(false);
+
+public:
+    // The ring has Blocks blocks of BlockSize bytes, allocated once, and the
+    // reader waits while all of them are full. Each read fills up to
+    // BlocksPerRead of them. HugePages is passed to BlockRing.
+    StreamParser(InputChannel& Input, size_t BlockSize = 1048576,
+        size_t BlocksPerRead = 4, size_t Blocks = 8, bool HugePages = false);
+    StreamParser(const StreamParser&) = delete;
+    StreamParser& operator=(const StreamParser&) = delete;
+    ~StreamParser();
+
+    // Parses one value using P, skipping whitespace before it. Input after
+    // the value is kept for the next call. Throws if the input ends before
+    // the value.
+    template<typename Parser>
+    void Parse(Parser& P, ParserPool& Pool) noexcept(false);
+
+
+    // Gives the input that has not been parsed yet, waiting for the next
+    // block if needed, and consumes it. Returns false when the input ended.
+    bool Next(const char*& Begin, const char*& End) noexcept(false);
+};
+
+template<typename Parser>
+void StreamParser::Parse(Parser& P, ParserPool& Pool) noexcept(false) {
+    while (true) {
+        if (position == end) {
+            if (!next())
+                throw StreamEndedEarly;
+            continue;
+        }
+        if (P.Finished()) {
+            // Whitespace before the value.
+            position = Pool.skipWhitespace(position, end);
+            if (position == nullptr) {
+                position = end;
+                continue;
+            }
+        }
+        const char* done = P.Parse(position, end, Pool);
+        if (done != nullptr) {
+            position = done;
+            return;
+        }
+        position = end;
+    }
+}
@@ -18,4 +18,9 @@ public:
     inline bool isWhitespace(const char C) {
         return C == ' ' || C == '\x9' || C == '\xA' || C == '\xD';
     }
+    // Characters that can be part of a JSON number.
+    inline bool isNumberChar(const char C) {
+        return ('0' <= C && C <= '9') || C == '.' || C == 'e' || C == 'E' ||
+            C == '-' || C == '+';
+    }
 };
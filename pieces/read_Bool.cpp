@@ -7,7 +7,7 @@ const char* specjson::ParseBool::Parse(
     if (!finished) {
         out = Pool.buffer.front() == 't';
     } else {
-        if (!*Begin)
+        if (Begin == End)
             return setFinished(nullptr, Pool);
         else if (*Begin == 't') {
             out = true; // Possibly.
@@ -0,0 +1 @@
+const Exception specjson::FixedStringTooLong("String longer than fixed size.");
@@ -0,0 +1,83 @@
+extern const Exception FixedStringTooLong;
+
+// String of at most N characters stored inline.
+template<size_t N>
+class FixedString {
+private:
+    typedef typename std::conditional<(N < 256), uint8_t, size_t>::type Length;
+    Length length;
+    char chars[N + 1];
+
+public:
+    FixedString() : length(0) { chars[0] = 0; }
+    FixedString(std::string_view S) { assign(S.data(), S.size()); }
+
+    void assign(const char* Chars, size_t Count) {
+        if (N < Count)
+            throw FixedStringTooLong;
+        std::memcpy(chars, Chars, Count);
+        chars[Count] = 0;
+        length = static_cast<Length>(Count);
+    }
+
+    static constexpr size_t max_size() { return N; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    const char* data() const { return chars; }
+    const char* c_str() const { return chars; }
+    const char* begin() const { return chars; }
+    const char* end() const { return chars + length; }
+    operator std::string_view() const { return std::string_view(chars, length); }
+
+    bool operator==(const FixedString& S) const {
+        return std::string_view(*this) == std::string_view(S);
+    }
+    bool operator!=(const FixedString& S) const { return !(*this == S); }
+};
+
+// Non-pooled so that each N can be used.
+template<size_t N>
+class ParseFixedString : public ValueParser {
+public:
+    typedef FixedString<N> Type;
+
+private:
+    Type out;
+
+public:
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+
+    void Swap(Type& Alt) { Alt = out; }
+};
+
+template<size_t N>
+const char* ParseFixedString<N>::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    ParseString& p(std::get<ParseString::Pool::Index>(Pool.Parser));
+    if (p.Finished() && *Begin == '"') {
+        // Strings without escapes are copied from the input buffer.
+        for (const char* curr = Begin + 1; curr != End; ++curr) {
+            if (*curr == '"') {
+                if (N < static_cast<size_t>(curr - Begin - 1))
+                    throw ContextException(FixedStringTooLong, Begin, curr, End);
+                out.assign(Begin + 1, curr - Begin - 1);
+                return setFinished(curr + 1);
+            }
+            if (*curr == '\\' || static_cast<unsigned char>(*curr) < 32)
+                break;
+        }
+    }
+    Begin = p.Parse(Begin, End, Pool);
+    if (Begin == nullptr)
+        return setFinished(nullptr);
+    const std::string& value(std::get<ParseString::Pool::Index>(Pool.Value));
+    out.assign(value.data(), value.size());
+    return setFinished(Begin);
+}
+
+template<typename Sink, size_t N>
+void Write(Sink& S, const FixedString<N>& Value, std::vector<char>& Buffer) {
+    Write(S, Value.begin(), Value.end(), Buffer);
+}
@@ -6,35 +6,27 @@ const char* specjson::ParseFloat::Parse(
     Type& out(std::get<ParseFloat::Pool::Index>(Pool.Value));
     char* end = nullptr;
     if (finished) {
+        // Find the end of the number so that conversion stays before End.
+        const char* stop = Begin;
+        while (stop != End && isNumberChar(*stop))
+            ++stop;
+        if (stop == End) {
+            // It is possible the number continues in next buffer.
+            Pool.buffer.insert(Pool.buffer.end(), Begin, End);
+            return setFinished(nullptr, Pool);
+        }
+        // Letters could continue hexadecimal, INF or NAN past stop.
+        if (stop == Begin || std::isalpha(static_cast<unsigned char>(*stop)))
+            throw InvalidFloat;
         // Assumes LC_NUMERIC is "C" or close enough.
         out = strtof(Begin, &end);
-        // It is possible the exponent is in next buffer.
-        if (end != Begin && end != End && !(*end == 'e' || *end == 'E')) {
-            // Detect hexadecimal significand and exponent, INF, NAN. ","
-            // This block is about 6% of parsing time if you tolerate the above.
-            while (Begin != end &&
-                (('0' <= *Begin && *Begin <= '9') ||
-                *Begin == '-' || *Begin == '+' || *Begin == '.' ||
-                *Begin == 'e' || *Begin == 'E'))
-                    ++Begin;
-            if (Begin != end)
-                throw InvalidFloat;
-            return setFinished(end); // Good up to this.
-        }
-        // Copy good chars to buffer. Either end cut off or invalid.
-        while (('0' <= *Begin && *Begin <= '9') || *Begin == '.' ||
-            *Begin == 'e' || *Begin == 'E' ||
-            *Begin == '-' || *Begin == '+')
-                Pool.buffer.push_back(*Begin++);
-        if (Begin != End) // Did not reach end of buffer, hence invalid.
+        if (end != stop)
             throw InvalidFloat;
-        return setFinished(nullptr, Pool);
+        return setFinished(end); // Good up to this.
     }
-    // Start of the number is in buffer. Input is null-terminated.
-    while (('0' <= *Begin && *Begin <= '9') || *Begin == '.' ||
-        *Begin == 'e' || *Begin == 'E' ||
-        *Begin == '-' || *Begin == '+')
-            Pool.buffer.push_back(*Begin++);
+    // Start of the number is in buffer.
+    while (Begin != End && isNumberChar(*Begin))
+        Pool.buffer.push_back(*Begin++);
     if (Begin == End) // Continues on and on?
         return setFinished(nullptr, Pool);
     Pool.buffer.push_back(0);
@@ -0,0 +1,109 @@
+static int insitu_hex(const char C) {
+    if ('0' <= C && C <= '9')
+        return C - '0';
+    if ('a' <= C && C <= 'f')
+        return 10 + C - 'a';
+    if ('A' <= C && C <= 'F')
+        return 10 + C - 'A';
+    return -1;
+}
+
+// Returns the closing quote, or nullptr if the string does not end before
+// End or is invalid. ParseString handles those and reports the errors.
+static const char* insitu_closing_quote(const char* Begin, const char* End) {
+    for (; Begin != End; ++Begin) {
+        if (*Begin == '"')
+            return Begin;
+        if (static_cast<unsigned char>(*Begin) < 32)
+            return nullptr;
+        if (*Begin != '\\')
+            continue;
+        if (++Begin == End)
+            return nullptr;
+        switch (*Begin) {
+        case '"':
+        case '/':
+        case '\\':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+            break;
+        case 'u':
+            for (int k = 0; k < 4; ++k)
+                if (++Begin == End || insitu_hex(*Begin) < 0)
+                    return nullptr;
+            break;
+        default:
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+// Unescapes valid string contents in place and returns the new end.
+static char* insitu_unescape(char* Begin, const char* End) {
+    char* out = Begin;
+    while (Begin != End) {
+        if (*Begin != '\\') {
+            *out++ = *Begin++;
+            continue;
+        }
+        ++Begin;
+        switch (*Begin++) {
+        case 'b': *out++ = '\b'; break;
+        case 'f': *out++ = '\f'; break;
+        case 'n': *out++ = '\n'; break;
+        case 'r': *out++ = '\r'; break;
+        case 't': *out++ = '\t'; break;
+        case 'u': {
+            int value = 0;
+            for (int k = 0; k < 4; ++k)
+                value = (value << 4) + insitu_hex(*Begin++);
+            if (value < 0x80)
+                *out++ = static_cast<char>(value);
+            else if (value < 0x800) {
+                *out++ = static_cast<char>(0xc0 | ((value >> 6) & 0x1f));
+                *out++ = static_cast<char>(0x80 | (value & 0x3f));
+            } else {
+                *out++ = static_cast<char>(0xe0 | ((value >> 12) & 0xf));
+                *out++ = static_cast<char>(0x80 | ((value >> 6) & 0x3f));
+                *out++ = static_cast<char>(0x80 | (value & 0x3f));
+            }
+            break;
+        }
+        default: // '"', '/' or '\\'.
+            *out++ = Begin[-1];
+        }
+    }
+    return out;
+}
+
+const char* specjson::ParseInSituString::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    ParseString& p(std::get<ParseString::Pool::Index>(Pool.Parser));
+    if (finished && p.Finished() && *Begin == '"') {
+        const char* close = insitu_closing_quote(Begin + 1, End);
+        if (close != nullptr) {
+            if (std::find(Begin + 1, close, '\\') == close) {
+                std::get<Pool::Index>(Pool.Value) =
+                    Type(Begin + 1, close - Begin - 1);
+                return setFinished(close + 1);
+            }
+            char* start = Pool.Writable(Begin + 1, close);
+            if (start != nullptr) {
+                char* last = insitu_unescape(start, close);
+                std::get<Pool::Index>(Pool.Value) = Type(start, last - start);
+                return setFinished(close + 1);
+            }
+        }
+    }
+    Begin = p.Parse(Begin, End, Pool);
+    if (Begin == nullptr)
+        return setFinished(nullptr);
+    storage.push_back(std::get<ParseString::Pool::Index>(Pool.Value));
+    std::get<Pool::Index>(Pool.Value) = storage.back();
+    return setFinished(Begin);
+}
@@ -0,0 +1,21 @@
+// Refers to the string in the input buffer. Escapes are decoded in place when
+// the caller has marked the input as writable with ParserPool SetWritable. A
+// string with escapes in other input, or that does not end in the same buffer,
+// is parsed by ParseString and the result is kept in storage owned by this
+// parser until Release is called.
+class ParseInSituString : public ValueParser {
+public:
+    typedef std::string_view Type;
+
+private:
+    std::deque<std::string> storage;
+
+public:
+    enum Pool { Index = PoolIndex };
+
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+
+    // Frees copies of strings that could not be decoded in place.
+    void Release() { storage.clear(); }
+};
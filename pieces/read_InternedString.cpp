@@ -0,0 +1,14 @@
+const char* specjson::ParseInternedString::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    ParseString& p(std::get<ParseString::Pool::Index>(Pool.Parser));
+    Begin = p.Parse(Begin, End, Pool);
+    if (Begin == nullptr)
+        return setFinished(nullptr);
+    const std::string& value(std::get<ParseString::Pool::Index>(Pool.Value));
+    auto iter = table.find(value);
+    if (iter == table.end())
+        iter = table.insert(value).first;
+    std::get<Pool::Index>(Pool.Value) = &(*iter);
+    return setFinished(Begin);
+}
@@ -0,0 +1,19 @@
+// Equal strings refer to the same shared copy kept by this parser in the
+// ParserPool until Release is called.
+class ParseInternedString : public ValueParser {
+public:
+    typedef const std::string* Type;
+
+private:
+    std::unordered_set<std::string> table;
+
+public:
+    enum Pool { Index = PoolIndex };
+
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+
+    // Frees the shared copies. Values parsed earlier become invalid.
+    void Release() { table.clear(); }
+    size_t Size() const { return table.size(); }
+};
@@ -0,0 +1,11 @@
+template<typename Parser>
+class ParsePmrContainerStdVector : public ParseContainerArray<PmrVector<typename Parser::Type>, Parser> {
+public:
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false)
+    {
+        if (this->Finished() && !this->began)
+            pmr_rebind(this->out);
+        return ParseContainerArray<PmrVector<typename Parser::Type>, Parser>::Parse(Begin, End, Pool);
+    }
+};
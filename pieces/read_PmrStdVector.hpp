@@ -0,0 +1,11 @@
+template<typename Parser>
+class ParsePmrStdVector : public ParseArray<PmrVector<typename Parser::Type>, Parser, false> {
+public:
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false)
+    {
+        if (this->Finished() && !this->began)
+            pmr_rebind(this->out);
+        return ParseArray<PmrVector<typename Parser::Type>, Parser, false>::Parse(Begin, End, Pool);
+    }
+};
@@ -0,0 +1,13 @@
+const char* specjson::ParsePmrString::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    ParseString& p(std::get<ParseString::Pool::Index>(Pool.Parser));
+    Begin = p.Parse(Begin, End, Pool);
+    if (Begin == nullptr)
+        return setFinished(nullptr);
+    Type& out(std::get<Pool::Index>(Pool.Value));
+    pmr_rebind(out);
+    const std::string& value(std::get<ParseString::Pool::Index>(Pool.Value));
+    out.assign(value.data(), value.size());
+    return setFinished(Begin);
+}
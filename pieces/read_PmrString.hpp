@@ -0,0 +1,9 @@
+class ParsePmrString : public ValueParser {
+public:
+    typedef PmrString Type;
+
+    enum Pool { Index = PoolIndex };
+
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+};
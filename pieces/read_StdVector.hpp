@@ -1,2 +1,48 @@
+// Arrays of numbers that are entirely in the buffer and at least threshold
+// bytes long are parsed in parallel once enabled using EnableParallel from the
+// ParallelArray piece. Off by default, so no threads are used otherwise.
 template<typename Parser>
-class ParseStdVector : public ParseArray<std::vector<typename Parser::Type>, Parser, false> { };
+class ParseStdVector : public ParseArray<std::vector<typename Parser::Type>, Parser, false> {
+public:
+    typedef std::vector<typename Parser::Type> Type;
+    typedef void (*ParallelParse)(const char* Begin, const char* End,
+        Type& Out, unsigned Threads);
+
+private:
+    ParallelParse parallel;
+    size_t threshold;
+    unsigned threads;
+
+public:
+    ParseStdVector() : parallel(nullptr), threshold(0), threads(0) { }
+
+    // Function parses arrays of at least Threshold bytes using Threads.
+    void SetParallel(ParallelParse Function, size_t Threshold, unsigned Threads)
+    {
+        parallel = (1 < Threads) ? Function : nullptr;
+        threshold = Threshold;
+        threads = Threads;
+    }
+
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false)
+    {
+        if (parallel != nullptr && this->Finished() && !this->began &&
+            threshold <= static_cast<size_t>(End - Begin) &&
+            Begin != End && *Begin == '[')
+        {
+            const char* close = static_cast<const char*>(
+                std::memchr(Begin, ']', End - Begin));
+            if (close != nullptr &&
+                threshold <= static_cast<size_t>(close - Begin))
+            {
+                const char* first = this->skipWhitespace(Begin + 1, close);
+                if (first != nullptr) {
+                    parallel(first, close, this->out, threads);
+                    return this->setFinished(close + 1);
+                }
+            }
+        }
+        return ParseArray<Type, Parser, false>::Parse(Begin, End, Pool);
+    }
+};
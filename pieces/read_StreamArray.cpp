@@ -0,0 +1 @@
+const Exception specjson::NoStreamCallback("Stream array callback not set.");
@@ -0,0 +1,69 @@
+extern const Exception NoStreamCallback;
+
+// Parses an array of scalars and passes the items to a callback in batches
+// instead of storing them. Type is the number of items in the array.
+template<typename Parser>
+class ParseStreamArray : public ParseArrayItems {
+public:
+    typedef size_t Type;
+    typedef typename Parser::Type Item;
+    typedef std::function<void(Item* Items, size_t Count)> Callback;
+
+private:
+    Callback callback;
+    std::unique_ptr<Item[]> batch;
+    size_t batch_size, used, count;
+
+    void store(Item& Value) {
+        batch[used++] = std::move(Value);
+        ++count;
+        if (used == batch_size)
+            flush();
+    }
+
+    void flush() {
+        if (used)
+            callback(batch.get(), used);
+        used = 0;
+    }
+
+    const char* finish(const char* Endptr) {
+        flush();
+        began = false;
+        return setFinished(Endptr);
+    }
+
+public:
+    ParseStreamArray() : batch_size(0), used(0), count(0) { }
+
+    // Callback gets at most BatchSize items at a time, 1 means every item.
+    void SetCallback(Callback CB, size_t BatchSize = 1024) {
+        callback = CB;
+        batch_size = BatchSize ? BatchSize : 1;
+        batch.reset(new Item[batch_size]);
+        used = 0;
+    }
+
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+
+    void Swap(Type& Alt) {
+        if (!Finished())
+            throw NotFinished;
+        Alt = count;
+        count = 0;
+    }
+};
+
+template<typename Parser>
+const char* ParseStreamArray<Parser>::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    Parser& p(std::get<Parser::Pool::Index>(Pool.Parser));
+    Item& value(std::get<Parser::Pool::Index>(Pool.Value));
+    if (p.Finished() && !began && !callback && *Begin == '[')
+        throw NoStreamCallback;
+    return parse_items(Begin, End, Pool, p, count == 0,
+        [&]() { store(value); },
+        [this](const char* Endptr) { return finish(Endptr); });
+}
@@ -30,7 +30,7 @@ const char* specjson::ParseString::Parse(
                         }
                         buffer.push_back(*Begin++);
                     } else {
-                        out.append(buffer.begin(), buffer.end());
+                        out.append(buffer.data(), buffer.size());
                         return setFinished(Begin + 1, Pool);
                     }
                 } else {
@@ -0,0 +1,83 @@
+// Strings stored one after another in one buffer with their start offsets.
+class StringTable {
+private:
+    std::vector<char> chars;
+    std::vector<size_t> offsets;
+
+public:
+    typedef std::string_view value_type;
+
+    class const_iterator {
+    private:
+        const StringTable* table;
+        size_t index;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::string_view value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string_view* pointer;
+        typedef std::string_view reference;
+
+        const_iterator(const StringTable* Table = nullptr, size_t Index = 0)
+            : table(Table), index(Index) { }
+        std::string_view operator*() const { return (*table)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { return const_iterator(table, index++); }
+        bool operator==(const const_iterator& I) const { return index == I.index; }
+        bool operator!=(const const_iterator& I) const { return index != I.index; }
+    };
+
+    StringTable() : offsets(1, 0) { }
+
+    size_t size() const { return offsets.size() - 1; }
+    bool empty() const { return offsets.size() == 1; }
+    // Total length of all strings.
+    size_t chars_size() const { return chars.size(); }
+
+    void reserve(size_t Strings, size_t Chars) {
+        offsets.reserve(Strings + 1);
+        chars.reserve(Chars);
+    }
+
+    void push_back(std::string_view S) {
+        chars.insert(chars.end(), S.begin(), S.end());
+        offsets.push_back(chars.size());
+    }
+
+    // Growing adds empty strings.
+    void resize(size_t Size) {
+        if (Size < size())
+            chars.resize(offsets[Size]);
+        offsets.resize(Size + 1, chars.size());
+    }
+
+    void clear() { resize(0); }
+
+    std::string_view operator[](size_t Index) const {
+        return std::string_view(chars.data() + offsets[Index],
+            offsets[Index + 1] - offsets[Index]);
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // Heap memory held, for AllocationStats.
+    friend void memory_use(
+        const StringTable& Value, size_t& Bytes, size_t& Blocks)
+    {
+        Bytes += Value.chars.capacity() +
+            Value.offsets.capacity() * sizeof(size_t);
+        Blocks += (Value.chars.capacity() ? 1 : 0) +
+            (Value.offsets.capacity() ? 1 : 0);
+    }
+};
+
+class ParseStringTable : public ParseArray<StringTable, ParseString> { };
+
+template<typename Sink>
+void Write(Sink& S, const StringTable& Value, std::vector<char>& Buffer) {
+    auto b = Value.begin();
+    auto e = Value.end();
+    Write<Sink,StringTable::const_iterator>(S, b, e, Buffer);
+}
@@ -0,0 +1,21 @@
+const char* specjson::ParseStringView::Parse(
+    const char* Begin, const char* End, ParserPool& Pool) noexcept(false)
+{
+    ParseString& p(std::get<ParseString::Pool::Index>(Pool.Parser));
+    if (finished && p.Finished() && *Begin == '"') {
+        for (const char* curr = Begin + 1; curr != End; ++curr) {
+            if (*curr == '"') {
+                std::get<Pool::Index>(Pool.Value) = Type(Begin + 1, curr - Begin - 1);
+                return setFinished(curr + 1);
+            }
+            if (*curr == '\\' || static_cast<unsigned char>(*curr) < 32)
+                break;
+        }
+    }
+    Begin = p.Parse(Begin, End, Pool);
+    if (Begin == nullptr)
+        return setFinished(nullptr);
+    storage.push_back(std::get<ParseString::Pool::Index>(Pool.Value));
+    std::get<Pool::Index>(Pool.Value) = storage.back();
+    return setFinished(Begin);
+}
@@ -0,0 +1,19 @@
+// Refers into the input buffer when the string has no escapes and ends in the
+// same buffer. Otherwise the string is parsed by ParseString and the result
+// is kept in storage owned by this parser until Release is called.
+class ParseStringView : public ValueParser {
+public:
+    typedef std::string_view Type;
+
+private:
+    std::deque<std::string> storage;
+
+public:
+    enum Pool { Index = PoolIndex };
+
+    const char* Parse(const char* Begin, const char* End, ParserPool& Pool)
+        noexcept(false);
+
+    // Frees copies of strings that could not refer to the input buffer.
+    void Release() { storage.clear(); }
+};
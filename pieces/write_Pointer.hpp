@@ -4,6 +4,6 @@ void Write(Sink& S, const T* Value, std::vector<char>& Buffer) {
         Write(S, *Value, Buffer);
     else {
         char null[] = "null";
-        S.write(&null, 4);
+        S.write(null, 4);
     }
 }
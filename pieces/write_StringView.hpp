@@ -0,0 +1,4 @@
+template<typename Sink>
+void Write(Sink& S, std::string_view Value, std::vector<char>& Buffer) {
+    Write(S, Value.data(), Value.data() + Value.size(), Buffer);
+}
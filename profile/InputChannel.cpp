@@ -1,12 +0,0 @@
-//
-//  InputChannel.cpp
-//  imageio / datalackey
-//
-//  Created by Ismo Kärkkäinen on 10.5.17.
-//  Copyright © 2017, 2020 Ismo Kärkkäinen. All rights reserved.
-//
-// Licensed under Universal Permissive License. See License.txt.
-
-#include "InputChannel.hpp"
-
-InputChannel::~InputChannel() { }
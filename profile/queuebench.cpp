@@ -0,0 +1,79 @@
+// Compares passing blocks from a reader thread to a parser thread using
+// BlockQueue and BlockRing. Prints the throughput for each block size. The
+// bounded BlockQueue has the same block count as the ring, so the difference
+// between those two comes from the queue and not from backpressure.
+
+#include "specificjsontest.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+
+using namespace specjson;
+
+const size_t total_bytes = 1ULL << 32;
+const size_t blocks = 8;
+
+// Consumer touches every block so the data is actually transferred.
+static size_t consume(const char* Begin, const char* End) {
+    return End - Begin + (Begin != End ? Begin[0] : 0);
+}
+
+// MaxBlocks 0 leaves BlockQueue unbounded.
+double queue_seconds(size_t BlockSize, size_t MaxBlocks) {
+    BlockQueue queue(MaxBlocks);
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&queue, BlockSize]() {
+        BlockQueue::BlockPtr block(new BlockQueue::Block());
+        for (size_t sent = 0; sent < total_bytes; sent += BlockSize) {
+            block->resize(BlockSize);
+            std::memset(block->data(), 1, 1);
+            block = queue.Add(block);
+        }
+        queue.End();
+    });
+    size_t received = 0;
+    BlockQueue::BlockPtr block;
+    while ((block = queue.Remove(block, true)))
+        received += consume(block->data(), block->data() + block->size());
+    producer.join();
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return received ? d.count() : 0.0;
+}
+
+double ring_seconds(size_t BlockSize) {
+    BlockRing ring(blocks, BlockSize);
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&ring, BlockSize]() {
+        struct iovec vector;
+        for (size_t sent = 0; sent < total_bytes; sent += BlockSize) {
+            ring.Acquire(&vector, 1);
+            std::memset(vector.iov_base, 1, 1);
+            ring.Publish(BlockSize);
+        }
+        ring.End();
+    });
+    size_t received = 0;
+    const char* begin;
+    const char* end;
+    while (ring.Next(begin, end))
+        received += consume(begin, end);
+    producer.join();
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return received ? d.count() : 0.0;
+}
+
+int main(int argc, char** argv) {
+    const size_t sizes[] = { 4096, 65536, 1048576 };
+    for (size_t size : sizes) {
+        double u = queue_seconds(size, 0);
+        double q = queue_seconds(size, blocks);
+        double r = ring_seconds(size);
+        std::cout << size << " byte blocks, GiB/s: BlockQueue unbounded "
+            << (total_bytes >> 30) / u << " bounded "
+            << (total_bytes >> 30) / q << " BlockRing "
+            << (total_bytes >> 30) / r << std::endl;
+    }
+    return 0;
+}
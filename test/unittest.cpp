@@ -11,9 +11,46 @@
 #include <sstream>
 #include <cstdint>
 #include <cinttypes>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <cstdio>
+#include <csignal>
+#include <cstring>
+#include <unistd.h>
+#include <sys/syscall.h>
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
 
 using namespace specjson;
 
+// Counts allocations so that tests can check parsing does not allocate.
+static std::atomic<size_t> allocations(0);
+
+void* operator new(size_t Size) {
+    ++allocations;
+    void* p = std::malloc(Size ? Size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+// The replacement operator new uses malloc, so free is the matching call.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* Ptr) noexcept { std::free(Ptr); }
+void operator delete(void* Ptr, size_t) noexcept { std::free(Ptr); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
 TEST_CASE("Write numbers") {
     std::vector<char> buf;
     SUBCASE("1.23456789f") {
@@ -850,6 +887,153 @@ TEST_CASE("String and escapes") {
     }
 }
 
+TEST_CASE("String view") {
+    ParserPool pp;
+    std::string_view& out(std::get<ParserPool::StringView>(pp.Value));
+    ParseStringView& parser(std::get<ParserPool::StringView>(pp.Parser));
+    SUBCASE("in buffer") {
+        std::string s("\"string\",");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + 8);
+        REQUIRE(out == "string");
+        REQUIRE(out.data() == s.c_str() + 1);
+    }
+    SUBCASE("escaped") {
+        std::string s("\"a\\nb\"");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        REQUIRE(out == "a\nb");
+        REQUIRE((out.data() < s.c_str() || s.c_str() + s.size() <= out.data()));
+    }
+    SUBCASE("str|ing") {
+        std::string s0("\"str");
+        std::string s("ing\"");
+        REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        REQUIRE(out == "string");
+        std::string_view first(out);
+        std::string s2("\"x\\ty\"");
+        REQUIRE(parser.Parse(s2.c_str(), s2.c_str() + s2.size(), pp) == s2.c_str() + s2.size());
+        REQUIRE(first == "string");
+        REQUIRE(out == "x\ty");
+        parser.Release();
+    }
+    SUBCASE("control character") {
+        std::string s("\"a\nb\"");
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("write") {
+        std::stringstream output;
+        std::vector<char> buffer;
+        Write(output, std::string_view("a\"b"), buffer);
+        REQUIRE(output.str() == "\"a\\\"b\"");
+    }
+}
+
+TEST_CASE("In-situ string") {
+    ParserPool pp;
+    std::string_view& out(std::get<ParserPool::InSituString>(pp.Value));
+    ParseInSituString& parser(std::get<ParserPool::InSituString>(pp.Parser));
+    SUBCASE("plain") {
+        std::string s("\"string\",");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + 8);
+        REQUIRE(out == "string");
+        REQUIRE(out.data() == s.c_str() + 1);
+    }
+    SUBCASE("escaped") {
+        std::string s("\"a\\n\\\"\\u00e4\\u20acb\"]");
+        pp.SetWritable(s.data(), s.data() + s.size());
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size() - 1);
+        REQUIRE(out == "a\n\"\xc3\xa4\xe2\x82\xac" "b");
+        REQUIRE(out.data() == s.c_str() + 1);
+    }
+    SUBCASE("escaped read-only") {
+        const std::string s("\"a\\nb\"");
+        const std::string original(s);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        REQUIRE(out == "a\nb");
+        REQUIRE(s == original);
+        REQUIRE(out.data() != s.c_str() + 1);
+        parser.Release();
+    }
+    SUBCASE("a\\|nb") {
+        std::string s0("\"a\\");
+        std::string s("nb\"");
+        REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+        REQUIRE(s0 == "\"a\\");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        REQUIRE(out == "a\nb");
+        parser.Release();
+    }
+    SUBCASE("invalid escape") {
+        std::string s("\"a\\xb\"");
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("invalid hex") {
+        std::string s("\"\\u00g0\"");
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+}
+
+TEST_CASE("Interned string") {
+    ParserPool pp;
+    const std::string*& out(std::get<ParserPool::InternedString>(pp.Value));
+    ParseInternedString& parser(std::get<ParserPool::InternedString>(pp.Parser));
+    std::string s("\"host\"");
+    REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+    const std::string* first = out;
+    REQUIRE(*first == "host");
+    std::string s0("\"ho");
+    std::string s1("st\"");
+    REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+    REQUIRE(parser.Parse(s1.c_str(), s1.c_str() + s1.size(), pp) == s1.c_str() + s1.size());
+    REQUIRE(out == first);
+    std::string s2("\"region\"");
+    REQUIRE(parser.Parse(s2.c_str(), s2.c_str() + s2.size(), pp) == s2.c_str() + s2.size());
+    REQUIRE(*out == "region");
+    REQUIRE(out != first);
+    REQUIRE(parser.Size() == 2);
+    std::stringstream output;
+    std::vector<char> buffer;
+    Write(output, first, buffer);
+    REQUIRE(output.str() == s);
+    parser.Release();
+    REQUIRE(parser.Size() == 0);
+}
+
+TEST_CASE("String table") {
+    ParserPool pp;
+    ParseStringTable parser;
+    StringTable out;
+    SUBCASE("[]") {
+        std::string s("[]");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.empty());
+    }
+    SUBCASE("strings") {
+        std::string s0("[\"a\", \"\", \"b\\");
+        std::string s("nc\",\"def\"]");
+        REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.size() == 4);
+        REQUIRE(out[0] == "a");
+        REQUIRE(out[1] == "");
+        REQUIRE(out[2] == "b\nc");
+        REQUIRE(out[3] == "def");
+        REQUIRE(out.chars_size() == 7);
+        std::vector<std::string> copy(out.begin(), out.end());
+        REQUIRE(copy[3] == "def");
+        std::stringstream output;
+        std::vector<char> buffer;
+        Write(output, out, buffer);
+        REQUIRE(output.str() == "[\"a\",\"\",\"b\\nc\",\"def\"]");
+        out.resize(2);
+        REQUIRE(out.chars_size() == 1);
+        out.push_back("x");
+        REQUIRE(out[2] == "x");
+    }
+}
+
 TEST_CASE("String Unicode") {
     ParserPool pp;
     std::string& out(std::get<ParserPool::String>(pp.Value));
@@ -1383,6 +1567,55 @@ TEST_CASE("Float array") {
     }
 }
 
+TEST_CASE("Parallel number array") {
+    ParserPool pp;
+    std::string s("[");
+    for (int k = 0; k < 1000; ++k)
+        s += (k ? ", " : " ") + std::to_string(k);
+    s += " ]";
+    SUBCASE("Int32") {
+        ParseStdVector<ParseInt32> parser;
+        EnableParallel(parser, 16, 4);
+        std::vector<int32_t> out;
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.size() == 1000);
+        for (int k = 0; k < 1000; ++k)
+            REQUIRE(out[k] == k);
+    }
+    SUBCASE("Float split over chunks") {
+        ParseStdVector<ParseFloat> parser;
+        EnableParallel(parser, 16, 4);
+        std::vector<float> out;
+        size_t half = s.size() / 2;
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + half, pp) == nullptr);
+        REQUIRE(parser.Parse(s.c_str() + half, s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.size() == 1000);
+        REQUIRE(out[999] == 999.0f);
+    }
+    SUBCASE("Off by default") {
+        ParseStdVector<ParseInt32> parser;
+        std::vector<int32_t> out;
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.size() == 1000);
+        REQUIRE(out[999] == 999);
+    }
+    SUBCASE("Invalid item") {
+        ParseStdVector<ParseInt32> parser;
+        EnableParallel(parser, 16, 4);
+        s[s.size() / 2] = 'x';
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("Empty item") {
+        ParseStdVector<ParseInt32> parser;
+        EnableParallel(parser, 16, 4);
+        s.insert(s.size() / 2, ",");
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+}
+
 TEST_CASE("Float array failures") {
     ParserPool pp;
     ParseArray<std::vector<ParseFloat::Type>,ParseFloat>::Type out;
@@ -1429,6 +1662,65 @@ TEST_CASE("Float array failures") {
     }
 }
 
+TEST_CASE("Float array into span") {
+    ParserPool pp;
+    float target[3] = { 0.0f, 0.0f, 0.0f };
+    ParseSpanArray<ParseFloat>::Type out;
+    SUBCASE("[]") {
+        ParseSpanArray<ParseFloat> parser;
+        parser.Target(target, 3);
+        std::string s("[]");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.empty());
+        REQUIRE(out.data() == target);
+    }
+    SUBCASE("[1,2,3]") {
+        ParseSpanArray<ParseFloat> parser;
+        parser.Target(target, 3);
+        std::string s("[1,2,3]");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.size() == 3);
+        REQUIRE(out.data() == target);
+        REQUIRE(target[0] == 1.0f);
+        REQUIRE(target[1] == 2.0f);
+        REQUIRE(target[2] == 3.0f);
+    }
+    SUBCASE("[1,|2]") {
+        ParseSpanArray<ParseFloat> parser;
+        parser.Target(target, 3);
+        std::string s0("[1,");
+        std::string s("2]");
+        REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.size() == 2);
+        REQUIRE(target[0] == 1.0f);
+        REQUIRE(target[1] == 2.0f);
+    }
+    SUBCASE("[1,2,3,4]") {
+        ParseSpanArray<ParseFloat> parser;
+        parser.Target(target, 3);
+        std::string s("[1,2,3,4]");
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("No target") {
+        ParseSpanArray<ParseFloat> parser;
+        std::string s("[1]");
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("Target cleared by Swap") {
+        ParseSpanArray<ParseFloat> parser;
+        parser.Target(target, 3);
+        std::string s("[1]");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out);
+        REQUIRE(out.size() == 1);
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+}
+
 TEST_CASE("Float array array") {
     ParserPool pp;
     ParseContainerArray<std::vector<ParseArray<std::vector<ParseFloat::Type>,ParseFloat>::Type>,ParseArray<std::vector<ParseFloat::Type>,ParseFloat>>::Type out;
@@ -1887,3 +2179,830 @@ TEST_CASE("Object invalid") {
         REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
     }
 }
+
+TEST_CASE("Object array as columns") {
+    ParserPool pp;
+    SUBCASE("Parse") {
+        Points_Parser parser;
+        std::string s("{\"points\":[{\"x\":1,\"y\":2},{\"y\":4,\"x\":3}],\"name\":\"a\"}");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        REQUIRE(parser.Finished() == true);
+        Points out;
+        parser.Swap(out.values);
+        REQUIRE(out.points().size() == 2);
+        REQUIRE(out.points().x().size() == 2);
+        REQUIRE(out.points().x()[0] == 1.0f);
+        REQUIRE(out.points().x()[1] == 3.0f);
+        REQUIRE(out.points().y().size() == 2);
+        REQUIRE(out.points().y()[0] == 2);
+        REQUIRE(out.points().y()[1] == 4);
+        REQUIRE(out.nameGiven() == true);
+        REQUIRE(out.name() == "a");
+    }
+    SUBCASE("Parse [{\"x\":1,|\"y\":2}]") {
+        Points_Parser parser;
+        std::string s0("{\"points\":[{\"x\":1,");
+        std::string s("\"y\":2}]}");
+        REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        Points out;
+        parser.Swap(out.values);
+        REQUIRE(out.points().size() == 1);
+        REQUIRE(out.points().x()[0] == 1.0f);
+        REQUIRE(out.points().y()[0] == 2);
+        REQUIRE(out.nameGiven() == false);
+    }
+    SUBCASE("Parse []") {
+        Points_Parser parser;
+        std::string s("{\"points\":[]}");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        Points out;
+        parser.Swap(out.values);
+        REQUIRE(out.points().empty());
+    }
+    SUBCASE("Missing field") {
+        Points_Parser parser;
+        std::string s("{\"points\":[{\"x\":1}]}");
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("Write") {
+        std::vector<char> buf;
+        std::basic_stringstream<char> s;
+        Point_Columns cols;
+        REQUIRE(cols.empty());
+        Write(s, cols, buf);
+        REQUIRE(s.str() == "[]");
+        cols.x().push_back(1.0f);
+        cols.y().push_back(2);
+        cols.x().push_back(3.0f);
+        cols.y().push_back(4);
+        s.str("");
+        Write(s, cols, buf);
+        REQUIRE(s.str() == "[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}]");
+    }
+    SUBCASE("Parse and write") {
+        Points_Parser parser;
+        std::string s("{\"points\":[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}]}");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        Points out;
+        parser.Swap(out.values);
+        std::vector<char> buf;
+        std::basic_stringstream<char> w;
+        Write(w, out, buf);
+        REQUIRE(w.str() == s);
+    }
+}
+
+TEST_CASE("Stream array") {
+    ParserPool pp;
+    std::vector<float> items;
+    std::vector<size_t> batches;
+    auto collect = [&items, &batches](float* Items, size_t Count) {
+        items.insert(items.end(), Items, Items + Count);
+        batches.push_back(Count);
+    };
+    SUBCASE("No callback") {
+        Stream_Parser parser;
+        std::string s("{\"items\":[1]}");
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("[]") {
+        Stream_Parser parser;
+        parser.FieldParser<0>().SetCallback(collect, 2);
+        std::string s("{\"items\":[ ]}");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        Stream out;
+        parser.Swap(out.values);
+        REQUIRE(out.items() == 0);
+        REQUIRE(batches.empty());
+    }
+    SUBCASE("[1,2,3,4,5]") {
+        Stream_Parser parser;
+        parser.FieldParser<0>().SetCallback(collect, 2);
+        std::string s("{\"items\":[1,2,3,4,5],\"count\":5}");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        Stream out;
+        parser.Swap(out.values);
+        REQUIRE(out.items() == 5);
+        REQUIRE(out.count() == 5);
+        REQUIRE(items == std::vector<float>({ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f }));
+        REQUIRE(batches == std::vector<size_t>({ 2, 2, 1 }));
+    }
+    SUBCASE("[1,|2,3|]") {
+        Stream_Parser parser;
+        parser.FieldParser<0>().SetCallback(collect, 1);
+        std::string s0("{\"items\":[1,");
+        std::string s1("2,3");
+        std::string s("]}");
+        REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+        REQUIRE(items.size() == 1);
+        REQUIRE(parser.Parse(s1.c_str(), s1.c_str() + s1.size(), pp) == nullptr);
+        REQUIRE(items.size() == 2);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        Stream out;
+        parser.Swap(out.values);
+        REQUIRE(out.items() == 3);
+        REQUIRE(items == std::vector<float>({ 1.0f, 2.0f, 3.0f }));
+    }
+}
+
+TEST_CASE("Arena allocated values") {
+    std::pmr::monotonic_buffer_resource arena;
+    std::string s(R"({"name":"arena","numbers":[1,2.5],"tags":[["a","bb"],[]]})");
+    SUBCASE("Parse in scope") {
+        PmrScope scope(&arena);
+        ParserPool pp;
+        Arena_Parser parser;
+        Arena out;
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out.values);
+        REQUIRE(out.name() == "arena");
+        REQUIRE(out.name().get_allocator().resource() == &arena);
+        REQUIRE(out.numbers().size() == 2);
+        REQUIRE(out.numbers()[1] == 2.5f);
+        REQUIRE(out.numbers().get_allocator().resource() == &arena);
+        REQUIRE(out.tags().size() == 2);
+        REQUIRE(out.tags()[0].size() == 2);
+        REQUIRE(out.tags()[0][1] == "bb");
+        REQUIRE(out.tags()[0][1].get_allocator().resource() == &arena);
+        REQUIRE(out.tags()[1].empty());
+        std::stringstream output;
+        std::vector<char> buffer;
+        Write(output, out, buffer);
+        REQUIRE(output.str() == s);
+    }
+    SUBCASE("Parser created outside scope") {
+        ParserPool pp;
+        Arena_Parser parser;
+        PmrScope scope(&arena);
+        Arena out;
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out.values);
+        REQUIRE(out.name().get_allocator().resource() == &arena);
+        REQUIRE(out.numbers().get_allocator().resource() == &arena);
+        REQUIRE(out.tags().get_allocator().resource() == &arena);
+    }
+    REQUIRE(PmrResource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("Enum") {
+    ParserPool pp;
+    SUBCASE("parse and write") {
+        std::string s(R"({"status":"on-hold","history":["active","\u00e4x","a\"b","","delete"]})");
+        Task_Parser parser;
+        Task out;
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out.values);
+        REQUIRE(out.status() == Status::on_hold);
+        REQUIRE(out.history().size() == 5);
+        REQUIRE(out.history()[0] == Status::active);
+        REQUIRE(out.history()[1] == Status::_x);
+        REQUIRE(out.history()[2] == Status::a_b);
+        REQUIRE(out.history()[3] == Status::_);
+        REQUIRE(out.history()[4] == Status::delete_);
+        std::stringstream output;
+        std::vector<char> buffer;
+        Write(output, out, buffer);
+        REQUIRE(output.str() == "{\"status\":\"on-hold\",\"history\":[\"active\",\"\xc3\xa4x\",\"a\\\"b\",\"\",\"delete\"]}");
+    }
+    SUBCASE("split") {
+        std::string s0(R"({"status":"inac)");
+        std::string s(R"(tive"})");
+        Task_Parser parser;
+        Task out;
+        REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out.values);
+        REQUIRE(out.status() == Status::inactive);
+    }
+    SUBCASE("unknown") {
+        std::string s(R"({"status":"actives"})");
+        Task_Parser parser;
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("unknown escaped") {
+        std::string s(R"({"status":"\u0061ctiv"})");
+        Task_Parser parser;
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+}
+
+TEST_CASE("Fixed string") {
+    ParserPool pp;
+    SUBCASE("parse and write") {
+        std::string s(R"({"currency":"EUR","codes":["ab","\u00e4x","","abcd"]})");
+        Codes_Parser parser;
+        Codes out;
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out.values);
+        REQUIRE(std::string_view(out.currency()) == "EUR");
+        REQUIRE(out.codes().size() == 4);
+        REQUIRE(std::string_view(out.codes()[1]) == "\xc3\xa4x");
+        REQUIRE(out.codes()[2].empty());
+        REQUIRE(out.codes()[3].size() == 4);
+        REQUIRE(sizeof(out.codes()[0]) == 6);
+        std::stringstream output;
+        std::vector<char> buffer;
+        Write(output, out, buffer);
+        REQUIRE(output.str() == "{\"currency\":\"EUR\",\"codes\":[\"ab\",\"\xc3\xa4x\",\"\",\"abcd\"]}");
+    }
+    SUBCASE("split") {
+        std::string s0(R"({"currency":"E)");
+        std::string s(R"(UR","codes":[]})");
+        Codes_Parser parser;
+        Codes out;
+        REQUIRE(parser.Parse(s0.c_str(), s0.c_str() + s0.size(), pp) == nullptr);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out.values);
+        REQUIRE(std::string_view(out.currency()) == "EUR");
+    }
+    SUBCASE("too long") {
+        std::string s(R"({"currency":"EURO","codes":[]})");
+        Codes_Parser parser;
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+    SUBCASE("too long escaped") {
+        std::string s(R"({"currency":"EU\u00e4","codes":[]})");
+        Codes_Parser parser;
+        REQUIRE_THROWS_AS(parser.Parse(s.c_str(), s.c_str() + s.size(), pp), Exception);
+    }
+}
+
+TEST_CASE("No allocations after warm-up") {
+    ParserPool pp;
+    Point_Parser parser;
+    Point out;
+    std::string s(R"({"x":1.5, "y" : -3})");
+    size_t half = s.size() / 2;
+    auto parse = [&]() {
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out.values);
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + half, pp) == nullptr);
+        REQUIRE(parser.Parse(s.c_str() + half, s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        parser.Swap(out.values);
+    };
+    parse();
+    size_t before = allocations;
+    for (int k = 0; k < 100; ++k)
+        parse();
+    size_t after = allocations;
+    REQUIRE(after == before);
+    REQUIRE(out.x() == 1.5f);
+    REQUIRE(out.y() == -3);
+    Point_Parser other;
+    REQUIRE(allocations == after);
+    SUBCASE("Key longer than short string buffer") {
+        Reading_Parser reading;
+        Reading value;
+        std::string r(R"({"sensor":7,"measured_temperature":21.5})");
+        auto parse_reading = [&]() {
+            REQUIRE(reading.Parse(r.c_str(), r.c_str() + half, pp) == nullptr);
+            REQUIRE(reading.Parse(r.c_str() + half, r.c_str() + r.size(), pp) == r.c_str() + r.size());
+            reading.Swap(value.values);
+        };
+        parse_reading();
+        before = allocations;
+        for (int k = 0; k < 100; ++k)
+            parse_reading();
+        REQUIRE(allocations == before);
+        REQUIRE(value.measured_temperature() == 21.5f);
+    }
+}
+
+TEST_CASE("Allocation stats") {
+    ParserPool pp;
+    AllocationStats stats;
+    pp.Stats = &stats;
+    std::string s(R"({"points":[{"x":1,"y":2},{"x":3,"y":4}],"name":"name longer than short string buffer"})");
+    Points_Parser parser;
+    Points out;
+    REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+    parser.Swap(out.values);
+    REQUIRE(stats.types.size() == 2);
+    const auto& point(stats.types[Point_TypeName]);
+    REQUIRE(point.total.values == 2);
+    REQUIRE(point.total.bytes == 0);
+    REQUIRE(point.names.size() == 2);
+    REQUIRE(std::string(point.names[1]) == "y");
+    const auto& points(stats.types[Points_TypeName]);
+    REQUIRE(points.total.values == 1);
+    REQUIRE(points.fields[0].blocks == 2);
+    REQUIRE(points.fields[0].bytes >= 2 * (sizeof(float) + sizeof(int32_t)));
+    REQUIRE(points.fields[1].blocks == 1);
+    REQUIRE(points.fields[1].bytes > out.name().size());
+    REQUIRE(points.total.bytes == points.fields[0].bytes + points.fields[1].bytes);
+    REQUIRE(points.total.largest == points.total.bytes);
+    std::stringstream output;
+    std::vector<char> buffer;
+    Write(output, stats, buffer);
+    REQUIRE(output.str().find(R"("Point":{"total":{"values":2,"bytes":0,"blocks":0,"largest":0},"fields":{"x":{)") != std::string::npos);
+    SUBCASE("Derived types") {
+        std::string a(R"({"name":"name longer than short string buffer","numbers":[1,2.5],"tags":[["a"]]})");
+        Arena_Parser arena;
+        REQUIRE(arena.Parse(a.c_str(), a.c_str() + a.size(), pp) == a.c_str() + a.size());
+        const auto& counted(stats.types[Arena_TypeName]);
+        REQUIRE(counted.fields[0].blocks == 1);
+        REQUIRE(counted.fields[0].bytes > 36);
+        REQUIRE(counted.fields[1].blocks == 1);
+        REQUIRE(counted.fields[1].bytes >= 2 * sizeof(float));
+        REQUIRE(counted.fields[2].blocks == 2);
+        StringTable table;
+        table.push_back("abc");
+        size_t bytes = 0, blocks = 0;
+        memory_use(table, bytes, blocks);
+        REQUIRE(blocks == 2);
+        REQUIRE(bytes >= 3 + 2 * sizeof(size_t));
+    }
+}
+
+TEST_CASE("Parse file") {
+    ParserPool pp;
+    Points_Parser parser;
+    Points out;
+    std::string s("{\"points\":[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}],\"name\":\"file\"}\n");
+    SUBCASE("Mapped") {
+        char name[] = "/tmp/specificjsontestXXXXXX";
+        int fd = mkstemp(name);
+        REQUIRE(fd >= 0);
+        REQUIRE(write(fd, s.c_str(), s.size()) == static_cast<ssize_t>(s.size()));
+        close(fd);
+        ParseFile(name, parser, pp);
+        std::remove(name);
+        parser.Swap(out.values);
+        REQUIRE(out.points().size() == 2);
+        REQUIRE(out.points().y()[1] == 4);
+        REQUIRE(out.name() == "file");
+    }
+    SUBCASE("Pipe") {
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+        REQUIRE(write(fds[1], s.c_str(), s.size()) == static_cast<ssize_t>(s.size()));
+        close(fds[1]);
+        ParseFile(fds[0], parser, pp, 7);
+        close(fds[0]);
+        parser.Swap(out.values);
+        REQUIRE(out.points().size() == 2);
+        REQUIRE(out.points().x()[1] == 3.0f);
+        REQUIRE(out.name() == "file");
+    }
+    SUBCASE("Leading whitespace") {
+        std::string w("\n  \t\r\n" + s);
+        SUBCASE("Mapped") {
+            char name[] = "/tmp/specificjsontestXXXXXX";
+            int fd = mkstemp(name);
+            REQUIRE(fd >= 0);
+            REQUIRE(write(fd, w.c_str(), w.size()) == static_cast<ssize_t>(w.size()));
+            close(fd);
+            ParseFile(name, parser, pp);
+            std::remove(name);
+        }
+        SUBCASE("Pipe") {
+            int fds[2];
+            REQUIRE(pipe(fds) == 0);
+            REQUIRE(write(fds[1], w.c_str(), w.size()) == static_cast<ssize_t>(w.size()));
+            close(fds[1]);
+            ParseFile(fds[0], parser, pp, 3);
+            close(fds[0]);
+        }
+        parser.Swap(out.values);
+        REQUIRE(out.points().size() == 2);
+        REQUIRE(out.name() == "file");
+    }
+    SUBCASE("Ended early") {
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+        REQUIRE(write(fds[1], s.c_str(), 10) == 10);
+        close(fds[1]);
+        REQUIRE_THROWS_AS(ParseFile(fds[0], parser, pp), Exception);
+        close(fds[0]);
+    }
+    SUBCASE("Missing") {
+        REQUIRE_THROWS_AS(ParseFile("/nonexistent/file.json", parser, pp), Exception);
+    }
+}
+
+TEST_CASE("Input end is respected") {
+    ParserPool pp;
+    // Characters after End must not be read as part of the value.
+    std::string s("{\"points\":[{\"x\":1.5,\"y\":2999}],\"name\":\"a\"}");
+    SUBCASE("Float array") {
+        ParseArray<std::vector<ParseFloat::Type>,ParseFloat> parser;
+        std::string a("[1.5,2999]");
+        REQUIRE(parser.Parse(a.c_str(), a.c_str() + 6, pp) == nullptr);
+        std::string b(".5]");
+        REQUIRE(parser.Parse(b.c_str(), b.c_str() + b.size(), pp) == b.c_str() + b.size());
+        std::vector<float> out;
+        parser.Swap(out);
+        REQUIRE(out.size() == 2);
+        REQUIRE(out[1] == 2.5f);
+    }
+    SUBCASE("Object") {
+        Points_Parser parser;
+        const char* split = s.c_str() + s.find("999");
+        REQUIRE(parser.Parse(s.c_str(), split, pp) == nullptr);
+        std::string b("0}]}");
+        REQUIRE(parser.Parse(b.c_str(), b.c_str() + b.size(), pp) == b.c_str() + b.size());
+        Points out;
+        parser.Swap(out.values);
+        REQUIRE(out.points().y()[0] == 20);
+    }
+    SUBCASE("Ends after string") {
+        Points_Parser parser;
+        const char* split = s.c_str() + s.find("\"}") + 1;
+        REQUIRE(parser.Parse(s.c_str(), split, pp) == nullptr);
+        REQUIRE(parser.Parse(split, s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        Points out;
+        parser.Swap(out.values);
+        REQUIRE(out.name() == "a");
+    }
+    SUBCASE("Hexadecimal float") {
+        ParseArray<std::vector<ParseFloat::Type>,ParseFloat> parser;
+        std::string a("[0x1p3]");
+        REQUIRE_THROWS_AS(parser.Parse(a.c_str(), a.c_str() + a.size(), pp), Exception);
+    }
+}
+
+TEST_CASE("Stream parser") {
+    ParserPool pp;
+    std::string s("{\"points\":[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}],\"name\":\"first\"} {\"points\":[],\"name\":\"second\"}");
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    REQUIRE(write(fds[1], s.c_str(), s.size()) == static_cast<ssize_t>(s.size()));
+    close(fds[1]);
+    FileDescriptorInput input(fds[0]);
+    SUBCASE("Values") {
+        StreamParser stream(input, 5);
+        Points_Parser parser;
+        Points out;
+        stream.Parse(parser, pp);
+        parser.Swap(out.values);
+        REQUIRE(out.points().size() == 2);
+        REQUIRE(out.points().y()[1] == 4);
+        REQUIRE(out.name() == "first");
+        stream.Parse(parser, pp);
+        parser.Swap(out.values);
+        REQUIRE(out.points().empty());
+        REQUIRE(out.name() == "second");
+        REQUIRE_THROWS_AS(stream.Parse(parser, pp), Exception);
+    }
+    SUBCASE("Huge pages") {
+        StreamParser stream(input, 4096, 2, 2, true);
+        Points_Parser parser;
+        Points out;
+        stream.Parse(parser, pp);
+        parser.Swap(out.values);
+        REQUIRE(out.name() == "first");
+    }
+    SUBCASE("Stop before end") {
+        StreamParser stream(input, 5);
+    }
+    close(fds[0]);
+}
+
+TEST_CASE("File descriptor input") {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    FileDescriptorInput input(fds[0], 10);
+    char a[3], b[4];
+    SUBCASE("Timeout") {
+        REQUIRE(input.Read(a, sizeof(a)) == 0);
+        REQUIRE(input.Ended() == false);
+        close(fds[1]);
+    }
+    SUBCASE("Vector") {
+        REQUIRE(write(fds[1], "abcdef", 6) == 6);
+        close(fds[1]);
+        struct iovec vectors[2] = { { a, sizeof(a) }, { b, sizeof(b) } };
+        REQUIRE(input.Read(vectors, 2) == 6);
+        REQUIRE(std::string(a, 3) == "abc");
+        REQUIRE(std::string(b, 3) == "def");
+        REQUIRE(input.Ended() == false);
+        REQUIRE(input.Read(vectors, 2) == 0);
+        REQUIRE(input.Ended() == true);
+    }
+    close(fds[0]);
+}
+
+TEST_CASE("Block ring") {
+    BlockRing ring(3, 4);
+    SUBCASE("Order") {
+        std::thread producer([&ring]() {
+            char next = 0;
+            struct iovec vectors[2];
+            while (next < 100) {
+                size_t count = ring.Acquire(vectors, 2);
+                size_t bytes = 0;
+                for (size_t k = 0; k < count; ++k)
+                    for (size_t n = 0; n < vectors[k].iov_len && next < 100; ++n, ++bytes)
+                        static_cast<char*>(vectors[k].iov_base)[n] = next++;
+                ring.Publish(bytes);
+            }
+            ring.End();
+        });
+        std::string received;
+        const char* begin;
+        const char* end;
+        while (ring.Next(begin, end)) {
+            REQUIRE(begin < end);
+            REQUIRE(end - begin <= 4);
+            received.append(begin, end);
+        }
+        producer.join();
+        REQUIRE(received.size() == 100);
+        for (size_t k = 0; k < received.size(); ++k)
+            REQUIRE(received[k] == static_cast<char>(k));
+    }
+    SUBCASE("Stop") {
+        struct iovec vectors[3];
+        REQUIRE(ring.Acquire(vectors, 3) == 3);
+        ring.Publish(12);
+        std::thread producer([&ring, &vectors]() {
+            CHECK(ring.Acquire(vectors, 3) == 0);
+        });
+        ring.Stop();
+        producer.join();
+    }
+}
+
+TEST_CASE("Bounded block queue") {
+    BlockQueue queue(2);
+    BlockQueue::BlockPtr first(new BlockQueue::Block());
+    BlockQueue::BlockPtr second(queue.Add(first));
+    REQUIRE(second);
+    REQUIRE(second != first);
+    BlockQueue::BlockPtr returned;
+    std::thread producer([&queue, &second, &returned]() {
+        returned = queue.Add(second);
+    });
+    // Add queues the block before it waits for one to be recycled.
+    while (queue.Size() < 2)
+        std::this_thread::yield();
+    BlockQueue::BlockPtr taken(queue.Remove());
+    REQUIRE(taken == first);
+    taken = queue.Remove(taken);
+    producer.join();
+    // The recycled block, as a third one could not be allocated.
+    REQUIRE(returned == first);
+    REQUIRE(taken == second);
+    SUBCASE("End while waiting") {
+        std::thread waiting([&queue, &taken]() {
+            CHECK(!queue.Add(taken));
+        });
+        while (queue.Size() < 1)
+            std::this_thread::yield();
+        queue.End();
+        waiting.join();
+    }
+}
+
+// Whether the kernel allows io_uring, so IoUringInput should use it.
+static bool io_uring_available() {
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, 1, &params));
+    if (fd < 0)
+        return false;
+    close(fd);
+    return true;
+#endif
+#endif
+    return false;
+}
+
+TEST_CASE("io_uring input") {
+    std::string s("0123456789abcdefghij");
+    char name[] = "/tmp/specificjsontestXXXXXX";
+    int fd = mkstemp(name);
+    REQUIRE(fd >= 0);
+    REQUIRE(write(fd, s.c_str(), s.size()) == static_cast<ssize_t>(s.size()));
+    REQUIRE(lseek(fd, 0, SEEK_SET) == 0);
+    char a[8], b[8], c[8];
+    struct iovec vectors[3] = { { a, 8 }, { b, 8 }, { c, 8 } };
+    SUBCASE("Uring") {
+        IoUringInput input(fd, 4);
+        REQUIRE(input.Uring() == io_uring_available());
+        REQUIRE(input.Read(vectors, 3) == 20);
+        REQUIRE(std::string(a, 8) == "01234567");
+        REQUIRE(std::string(b, 8) == "89abcdef");
+        REQUIRE(std::string(c, 4) == "ghij");
+        REQUIRE(input.Ended() == true);
+        REQUIRE(input.Read(vectors, 3) == 0);
+    }
+    SUBCASE("Read ahead") {
+        // Blocks smaller than reads and reads not aligned to blocks.
+        IoUringInput input(fd, 2, true, 3);
+        REQUIRE(input.Uring() == io_uring_available());
+        REQUIRE(input.Read(a, 5) == 5);
+        REQUIRE(input.Read(vectors + 1, 2) == 15);
+        REQUIRE(std::string(a, 5) == "01234");
+        REQUIRE(std::string(b, 8) == "56789abc");
+        REQUIRE(std::string(c, 7) == "defghij");
+        REQUIRE(input.Ended() == true);
+    }
+    SUBCASE("Fallback") {
+        IoUringInput input(fd, 4, false);
+        REQUIRE(input.Uring() == false);
+        REQUIRE(input.Read(a, 8) == 8);
+        REQUIRE(input.Read(vectors + 1, 2) == 12);
+        REQUIRE(std::string(a, 8) == "01234567");
+        REQUIRE(std::string(c, 4) == "ghij");
+    }
+    SUBCASE("Stream") {
+        std::string json("{\"points\":[{\"x\":1,\"y\":2}],\"name\":\"uring\"}");
+        REQUIRE(ftruncate(fd, 0) == 0);
+        REQUIRE(pwrite(fd, json.c_str(), json.size(), 0) == static_cast<ssize_t>(json.size()));
+        IoUringInput input(fd, 4);
+        StreamParser stream(input, 8, 4, 8);
+        ParserPool pp;
+        Points_Parser parser;
+        Points out;
+        stream.Parse(parser, pp);
+        parser.Swap(out.values);
+        REQUIRE(out.name() == "uring");
+    }
+    close(fd);
+    std::remove(name);
+}
+
+TEST_CASE("File descriptor sink") {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    std::vector<char> buf;
+    std::string expected;
+    {
+        FileDescriptorSink sink(fds[1], 16, 8);
+        Points_Parser parser;
+        ParserPool pp;
+        std::string s("{\"points\":[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}],\"name\":\"name longer than direct\"}");
+        REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+        Points out;
+        parser.Swap(out.values);
+        Write(sink, out, buf);
+        sink.write("xy", 2);
+        sink.Flush();
+        expected = s + "xy";
+    }
+    close(fds[1]);
+    std::string received;
+    char block[64];
+    ssize_t count;
+    while ((count = read(fds[0], block, sizeof(block))) > 0)
+        received.append(block, count);
+    close(fds[0]);
+    REQUIRE(received == expected);
+}
+
+TEST_CASE("Asynchronous sink") {
+    std::string s("{\"points\":[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}],\"name\":\"name longer than buffer\"}");
+    ParserPool pp;
+    Points_Parser parser;
+    REQUIRE(parser.Parse(s.c_str(), s.c_str() + s.size(), pp) == s.c_str() + s.size());
+    Points out;
+    parser.Swap(out.values);
+    std::vector<char> buf;
+    SUBCASE("Stream") {
+        std::stringstream output;
+        AsyncSink sink(output, 7);
+        for (int k = 0; k < 3; ++k)
+            Write(sink, out, buf);
+        sink.close();
+        REQUIRE(output.str() == s + s + s);
+    }
+    SUBCASE("File descriptor") {
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+        {
+            AsyncSink sink(fds[1], 16);
+            Write(sink, out, buf);
+            sink.close();
+        }
+        close(fds[1]);
+        std::string received;
+        char block[64];
+        ssize_t count;
+        while ((count = read(fds[0], block, sizeof(block))) > 0)
+            received.append(block, count);
+        close(fds[0]);
+        REQUIRE(received == s);
+    }
+    SUBCASE("Error") {
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+        close(fds[0]);
+        // Writing to the closed pipe fails with EPIPE instead of a signal.
+        void (*previous)(int) = signal(SIGPIPE, SIG_IGN);
+        {
+            AsyncSink sink(fds[1], 16);
+            CHECK_THROWS_AS({ Write(sink, out, buf); sink.close(); }, Exception);
+        }
+        signal(SIGPIPE, previous);
+        close(fds[1]);
+    }
+}
+
+TEST_CASE("Decompressing input") {
+    const std::string gz(
+        "\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03\xab\x56\x2a\xc8\xcf\xcc"
+        "\x2b\x29\x56\xb2\x8a\xae\x56\xaa\x50\xb2\x32\xd4\x51\xaa\x54\xb2"
+        "\x32\xaa\xd5\x01\xf3\x8c\xc1\x3c\x93\xda\x58\x1d\xa5\xbc\xc4\xdc"
+        "\x54\x25\x2b\xa5\xb4\xcc\xa2\xe2\x12\xa5\x5a\x2e\x00\xaa\x90\x0f"
+        "\x09\x38\x00\x00\x00\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03\x53"
+        "\x50\x18\x05\xc4\x82\x6a\xa5\x82\xfc\xcc\xbc\x92\x62\x25\xab\xe8"
+        "\x58\x1d\xa5\xbc\xc4\xdc\x54\x25\x2b\xa5\xe2\xd4\xe4\xfc\xbc\x14"
+        "\xa5\x5a\x00\x62\x37\xbc\x91\x49\x01\x00\x00", 123);
+    std::string data = gz;
+    bool truncated = false;
+    SUBCASE("Gzip") { }
+    SUBCASE("Plain") {
+        data = "{\"points\":[],\"name\":\"first\"} {\"points\":[],\"name\":\"second\"}";
+    }
+    SUBCASE("Truncated") {
+        data.resize(data.size() - 30);
+        truncated = true;
+    }
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    REQUIRE(write(fds[1], data.c_str(), data.size()) == static_cast<ssize_t>(data.size()));
+    close(fds[1]);
+    FileDescriptorInput input(fds[0]);
+    DecompressingInput decompressing(input, 16);
+    ParserPool pp;
+    Points_Parser parser;
+    Points out;
+    {
+        StreamParser stream(decompressing, 32, 2, 4);
+        if (truncated)
+            REQUIRE_THROWS_AS({
+                stream.Parse(parser, pp);
+                stream.Parse(parser, pp);
+            }, Exception);
+        else if (data != gz || DecompressingInput::Available(DecompressingInput::Gzip)) {
+            stream.Parse(parser, pp);
+            parser.Swap(out.values);
+            REQUIRE(out.name() == "first");
+            stream.Parse(parser, pp);
+            parser.Swap(out.values);
+            REQUIRE(out.name() == "second");
+            REQUIRE_THROWS_AS(stream.Parse(parser, pp), Exception);
+        } else
+            REQUIRE_THROWS_AS(stream.Parse(parser, pp), Exception);
+    }
+    close(fds[0]);
+}
+
+TEST_CASE("Parse sequence") {
+    std::string s("{\"points\":[{\"x\":1,\"y\":2}],\"name\":\"a long name that is not in small string\"}\n"
+        "{\"points\":[{\"x\":3,\"y\":4},{\"x\":5,\"y\":6}],\"name\":\"b\"}\r\n\n"
+        "  {\"points\":[]}\n");
+    ParserPool pp;
+    std::vector<std::string> names;
+    std::vector<size_t> sizes;
+    size_t capacity = 0;
+    ParseSequence<Points_Parser> sequence([&](Points_Parser::Type& V) {
+        Points out;
+        std::swap(out.values, V);
+        names.push_back(out.nameGiven() ? out.name() : std::string("-"));
+        sizes.push_back(out.points().size());
+        capacity = out.name().capacity();
+        std::swap(out.values, V);
+    });
+    SUBCASE("Chunks") {
+        for (size_t chunk = 1; chunk <= s.size(); ++chunk) {
+            names.clear();
+            sizes.clear();
+            for (size_t k = 0; k < s.size(); k += chunk)
+                sequence.Parse(s.c_str() + k,
+                    s.c_str() + std::min(k + chunk, s.size()), pp);
+            sequence.Finish();
+            REQUIRE(names == std::vector<std::string>({ "a long name that is not in small string", "b", "-" }));
+            REQUIRE(sizes == std::vector<size_t>({ 1, 2, 0 }));
+        }
+        REQUIRE(sequence.Count() == 3 * s.size());
+        // The string of the first value is emptied and re-used.
+        REQUIRE(capacity >= 39);
+    }
+    SUBCASE("Ended early") {
+        sequence.Parse(s.c_str(), s.c_str() + 20, pp);
+        REQUIRE_THROWS_AS(sequence.Finish(), Exception);
+    }
+    SUBCASE("Missing required") {
+        std::string bad("{\"name\":\"x\"}");
+        REQUIRE_THROWS_AS(sequence.Parse(bad.c_str(), bad.c_str() + bad.size(), pp), Exception);
+    }
+    SUBCASE("Stream") {
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+        REQUIRE(write(fds[1], s.c_str(), s.size()) == static_cast<ssize_t>(s.size()));
+        close(fds[1]);
+        FileDescriptorInput input(fds[0]);
+        {
+            StreamParser stream(input, 7, 2, 4);
+            sequence.Parse(stream, pp);
+        }
+        close(fds[0]);
+        REQUIRE(names.size() == 3);
+        REQUIRE(names[1] == "b");
+    }
+}